@@ -1,20 +1,32 @@
 #include <pebble.h>
 #include "battery.h"
+#include "../layout.h"
+#include "mission.h"
+#include "endurance.h"
+#include "../windows/check_msg.h"
+#include "../services/battery_monitor.h"
+#include "../services/flight_plan.h"
+#include "../services/profile.h"
+
+// Taxi on both ends and some margin on top of the planned flight
+#define BATTERY_TAXI_ALLOWANCE (30 * SECONDS_PER_MINUTE)
+#define BATTERY_RESERVE (60 * SECONDS_PER_MINUTE)
 
 static Layer *s_battery_layer;
 static int s_battery_level;
 
-void battery_init(Layer *window_layer, GRect bounds) {
-  s_battery_layer = layer_create(GRect(0, 58, bounds.size.w, 2));
+void battery_create(Layer *window_layer) {
+  s_battery_layer = layer_create(LAYOUT_BATTERY);
   layer_set_update_proc(s_battery_layer, battery_update_proc);
   layer_add_child(window_layer, s_battery_layer);
 }
 
 void battery_destroy() {
   layer_destroy(s_battery_layer);
+  s_battery_layer = NULL;
 }
 
-void battery_update_proc(Layer *layer, GContext *ctx) {
+static void draw(Layer *layer, GContext *ctx) {
   GRect bounds = layer_get_bounds(layer);
   
   int width = (int)(float)(((float)s_battery_level /100.0F) * bounds.size.w);
@@ -23,7 +35,42 @@ void battery_update_proc(Layer *layer, GContext *ctx) {
   graphics_fill_rect(ctx, GRect((bounds.size.w - width) / 2, 0, width, bounds.size.h), 0, GCornerNone);
 }
 
-void battery_callback(BatteryChargeState state) {
+void battery_update_proc(Layer *layer, GContext *ctx) {
+  PROFILE_CALL(PROFILE_DRAW_BATTERY, draw(layer, ctx));
+}
+
+// Planned end of the flight, 0 without a plan or once on block. The route of
+// the flight plan, or the endurance at take-off at worst.
+static time_t planned_block_end(time_t now) {
+  time_t planned = flight_plan_is_loaded() ? flight_plan_get_duration() : endurance_get_takeoff_value();
+  if (planned == 0 || mission_get_timestamp(ON_BLOCK) != 0) {
+    return 0;
+  }
+  time_t off_block = mission_get_timestamp(OFF_BLOCK);
+  return (off_block != 0 ? off_block : now) + planned + BATTERY_TAXI_ALLOWANCE;
+}
+
+void battery_check_forecast() {
+  time_t now = time(NULL);
+  time_t end = planned_block_end(now);
+  
+  if (end == 0 || battery_monitor_get_remaining() >= end - now + BATTERY_RESERVE) {
+    alarm_stop(ALARM_BATTERY);
+  } else if (!alarm_is_active(ALARM_BATTERY)) {
+    alarm_display(ALARM_BATTERY);
+  }
+}
+
+void battery_sample(BatteryChargeState state) {
   s_battery_level = state.charge_percent;
-  layer_mark_dirty(s_battery_layer);
+  // The first sample is taken before the layer is created
+  if (s_battery_layer != NULL) {
+    layer_mark_dirty(s_battery_layer);
+  }
+  battery_monitor_sample(state);
+}
+
+void battery_callback(BatteryChargeState state) {
+  battery_sample(state);
+  battery_check_forecast();
 }
\ No newline at end of file
@@ -1,7 +1,12 @@
 #pragma once
 #include <pebble.h>
 
-void battery_init(Layer *window_layer, GRect bounds);
+void battery_create(Layer *window_layer);
 void battery_destroy();
 void battery_update_proc(Layer *layer, GContext *ctx);
-void battery_callback(BatteryChargeState state);
\ No newline at end of file
+// Records the charge without checking the forecast, for the first sample
+// taken before any window is shown
+void battery_sample(BatteryChargeState state);
+void battery_callback(BatteryChargeState state);
+// Raises the battery alarm when the watch may not last the planned flight
+void battery_check_forecast();
\ No newline at end of file
@@ -1,6 +1,6 @@
 #pragma once
 #include <pebble.h>
 
-void clock_init(Layer *window_layer, GRect bounds);
+void clock_create(Layer *window_layer);
 void clock_update(time_t tick);
 void clock_destroy();
\ No newline at end of file
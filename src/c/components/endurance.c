@@ -2,22 +2,34 @@
 #include "endurance.h"
 #include "mission.h"
 #include "../utils.h"
+#include "../layout.h"
+#include "../services/profile.h"
+#include "../services/settings.h"
+#include "../windows/timeline_window.h"
 
 Layer *s_endurance_layer;
 static time_t s_endurance_at_takeoff = 0;
 static int s_endurance_level = -1;
 
-void endurance_init(Layer *window_layer, GRect bounds) {
-  s_endurance_layer = layer_create(GRect(0, 107, bounds.size.w, 10));
+void endurance_create(Layer *window_layer) {
+  s_endurance_layer = layer_create(LAYOUT_ENDURANCE);
   layer_set_update_proc(s_endurance_layer, endurance_update_proc);
   layer_add_child(window_layer, s_endurance_layer);
 }
 
 void endurance_destroy() {
   layer_destroy(s_endurance_layer);
+  s_endurance_layer = NULL;
 }
 
-void endurance_update_proc(Layer *layer, GContext *ctx) {
+// The endurance may be restored before the layer is created
+static void mark_dirty() {
+  if (s_endurance_layer != NULL) {
+    layer_mark_dirty(s_endurance_layer);
+  }
+}
+
+static void draw(Layer *layer, GContext *ctx) {
   
   if (s_endurance_level < 0) {
     return;
@@ -29,12 +41,17 @@ void endurance_update_proc(Layer *layer, GContext *ctx) {
   graphics_context_set_fill_color(ctx, GColorWhite);
   graphics_fill_rect(ctx, GRect((bounds.size.w - width), 4, width, bounds.size.h / 5), 0, GCornerNone);
   
-  if (s_endurance_at_takeoff > 45 * SECONDS_PER_MINUTE) {
-    int mark_pos = bounds.size.w - (int)(float)((45 * SECONDS_PER_MINUTE / (float) s_endurance_at_takeoff) * bounds.size.w);
+  time_t reserve = settings_get(SETTING_FUEL_RESERVE);
+  if (s_endurance_at_takeoff > reserve) {
+    int mark_pos = bounds.size.w - (int)(float)((reserve / (float) s_endurance_at_takeoff) * bounds.size.w);
     graphics_fill_rect(ctx, GRect(mark_pos, 0, 2, bounds.size.h), 0, GCornerNone);
   }
 }
 
+void endurance_update_proc(Layer *layer, GContext *ctx) {
+  PROFILE_CALL(PROFILE_DRAW_ENDURANCE, draw(layer, ctx));
+}
+
 static void update_mission_display(time_t endurance_left) {
   mission_set_timestamp(ENDURANCE, endurance_left);
   format_duration_hhmm(endurance_left, mission_get_info_buffer(ENDURANCE), INFO_BUFFER_SIZE);
@@ -42,6 +59,7 @@ static void update_mission_display(time_t endurance_left) {
 
 void endurance_set_takeoff_value(time_t duration) {
   s_endurance_at_takeoff = duration;
+  timeline_window_invalidate();
   if (duration == 0) {
     mission_set_status(ENDURANCE, false);
   } else {
@@ -57,7 +75,7 @@ time_t endurance_get_takeoff_value() {
 void endurance_update() {
   if (s_endurance_at_takeoff == 0) {
     s_endurance_level = -1;
-    layer_mark_dirty(s_endurance_layer);
+    mark_dirty();
     return;
   }
   
@@ -73,5 +91,5 @@ void endurance_update() {
     update_mission_display(endurance_left);
   }
   
-  layer_mark_dirty(s_endurance_layer);
+  mark_dirty();
 }
\ No newline at end of file
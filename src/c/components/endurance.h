@@ -1,7 +1,7 @@
 #pragma once
 #include <pebble.h>
 
-void endurance_init(Layer *window_layer, GRect bounds);
+void endurance_create(Layer *window_layer);
 void endurance_destroy();
 void endurance_update_proc(Layer *layer, GContext *ctx);
 
@@ -1,48 +1,121 @@
 #include <pebble.h>
 #include "et.h"
 #include "../utils.h"
+#include "../layout.h"
+#include "../services/digit_font.h"
+#include "../services/telemetry.h"
+#include "../services/latency_trace.h"
+#include "../services/profile.h"
+#include "../services/power.h"
 
+// Start of the stopwatch, to the millisecond
 static time_t s_et_start;
+static uint16_t s_et_start_ms;
 
-static TextLayer *s_counter;
-static TextLayer *s_start_minute;
+// The stopwatch runs its own timer, phased on the start rather than on the
+// wall clock seconds, and only while the main window is on screen. The
+// power profile sets how often it wakes up.
+static AppTimer *s_et_timer;
+static bool s_visible;
+static bool s_tenths;
+
+static Layer *s_counter;
+static Layer *s_start_minute;
 
 static TextLayer *s_desc;
 
-void et_init(Layer *window_layer, GRect bounds) {
-  s_counter = configure_text_layer(window_layer, GRect(0, 115, bounds.size.w, 44), fonts_get_system_font(FONT_KEY_BITHAM_42_LIGHT), GTextAlignmentRight);
-  s_start_minute = configure_text_layer(window_layer, GRect(0, 115, bounds.size.w, 44), fonts_get_system_font(FONT_KEY_BITHAM_34_MEDIUM_NUMBERS), GTextAlignmentLeft);
-  s_desc = configure_text_layer(window_layer, GRect(10, bounds.size.h - 26, 20, 26), fonts_get_system_font(FONT_KEY_GOTHIC_24), GTextAlignmentLeft);
+static char s_start_buffer[] = "xx";
+
+void et_create(Layer *window_layer) {
+  s_counter = configure_digit_layer(window_layer, LAYOUT_ET_COUNTER, digit_font_get(LAYOUT_ET_FONT), GTextAlignmentRight);
+  s_start_minute = configure_digit_layer(window_layer, LAYOUT_ET_START, fonts_get_system_font(FONT_KEY_BITHAM_34_MEDIUM_NUMBERS), GTextAlignmentLeft);
+  s_desc = configure_text_layer(window_layer, LAYOUT_ET_DESC, fonts_get_system_font(FONT_KEY_GOTHIC_24), GTextAlignmentLeft);
   text_layer_set_text(s_desc, "ET");
 }
 
 void et_destroy() {
-  text_layer_destroy(s_counter);
-  text_layer_destroy(s_start_minute);
+  if (s_et_timer != NULL) {
+    app_timer_cancel(s_et_timer);
+    s_et_timer = NULL;
+  }
+  digit_layer_destroy(s_counter);
+  digit_layer_destroy(s_start_minute);
   text_layer_destroy(s_desc);
 }
 
-void elapsed_time_update(time_t tick) {
-  int elapsed_time = tick - s_et_start;
-  int seconds = (int)elapsed_time % 60;
-  int minutes = (int)elapsed_time / 60 % 100;
+static int32_t elapsed_ms() {
+  time_t now;
+  uint16_t now_ms;
+  time_ms(&now, &now_ms);
+  return (int32_t)(now - s_et_start) * 1000 + now_ms - s_et_start_ms;
+}
+
+static void show(int32_t elapsed, bool tenths) {
+  int elapsed_time = elapsed / 1000;
+  int seconds = elapsed_time % 60;
+  int minutes = elapsed_time / 60 % 100;
   
-  static char et_buffer[] = "00:00";
-  snprintf(et_buffer, sizeof(et_buffer), "%d:%02d", minutes, seconds);
-  text_layer_set_text(s_counter, et_buffer);
+  static char et_buffer[] = "00:00.0";
+  if (tenths) {
+    snprintf(et_buffer, sizeof(et_buffer), "%d:%02d.%d", minutes, seconds, (int)(elapsed / 100 % 10));
+  } else {
+    snprintf(et_buffer, sizeof(et_buffer), "%d:%02d", minutes, seconds);
+  }
+  digit_layer_set_text(s_counter, et_buffer);
+  
+  // The tenths take the room of the start minute
+  bool show_start = !tenths && elapsed_time <= 60 * 100;
+  digit_layer_set_text(s_start_minute, show_start ? s_start_buffer : "");
+}
+
+static void et_timer_callback(void *data);
+
+// Shows the elapsed time and wakes up on the next period after the start
+static void refresh() {
+  if (s_et_timer != NULL) {
+    app_timer_cancel(s_et_timer);
+    s_et_timer = NULL;
+  }
+  if (!s_visible) {
+    return;
+  }
   
-  if (elapsed_time > 60 * 100) {
-    text_layer_set_text(s_start_minute, "");
+  int32_t elapsed = elapsed_ms();
+  if (elapsed < 0) {
+    elapsed = 0;
   }
+  int32_t period = power_get_stopwatch_period(s_tenths);
+  show(elapsed, period < 1000);
+  s_et_timer = app_timer_register(period - elapsed % period, et_timer_callback, NULL);
+}
+
+static void et_timer_callback(void *data) {
+  s_et_timer = NULL;
+  PROFILE_CALL(PROFILE_ET, refresh());
+}
+
+void elapsed_time_set_visible(bool visible) {
+  s_visible = visible;
+  power_set_stopwatch(s_visible, s_tenths);
+  refresh();
+}
+
+void elapsed_time_set_tenths(bool tenths) {
+  s_tenths = tenths;
+  power_set_stopwatch(s_visible, s_tenths);
+  refresh();
+}
+
+bool elapsed_time_get_tenths() {
+  return s_tenths;
 }
 
 void elapsed_time_flyback() {
-  s_et_start = time(NULL);
+  time_ms(&s_et_start, &s_et_start_ms);
   struct tm *tick_time_z = gmtime(&s_et_start);
+  snprintf(s_start_buffer, sizeof(s_start_buffer), "%02d", tick_time_z->tm_min);
   
-  static char et_start_buffer[] = "xx";
-  snprintf(et_start_buffer, sizeof(et_start_buffer), "%02d", tick_time_z->tm_min);
-  text_layer_set_text(s_start_minute, et_start_buffer);
-  
-  elapsed_time_update(s_et_start);
-}
\ No newline at end of file
+  refresh();
+  telemetry_log(EVENT_ET_FLYBACK, 0);
+  latency_trace_state();
+}
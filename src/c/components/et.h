@@ -1,7 +1,12 @@
 #pragma once
 #include <pebble.h>
 
-void et_init(Layer *window_layer, GRect bounds);
+void et_create(Layer *window_layer);
 void et_destroy();
 void elapsed_time_flyback();
-void elapsed_time_update(time_t tick);
\ No newline at end of file
+// The stopwatch only updates while its window is on screen
+void elapsed_time_set_visible(bool visible);
+// Shows tenths of a second, updating every 100 ms, unless the power profile
+// updates the stopwatch less often
+void elapsed_time_set_tenths(bool tenths);
+bool elapsed_time_get_tenths();
@@ -1,14 +1,32 @@
 #include <pebble.h>
 #include "mission.h"
 #include "../utils.h"
+#include "../layout.h"
 #include "../windows/check_msg.h"
-
-#define PHASE_COUNT 5
-#define CRUISE_CHECK_PERIOD_IN_MINUTES 15
+#include "../windows/checklist_window.h"
+#include "../windows/timeline_window.h"
+#include "../services/logbook.h"
+#include "../services/telemetry.h"
+#include "../services/flight_plan.h"
+#include "../services/sun.h"
+#include "../services/digit_font.h"
+#include "../services/heap_guard.h"
+#include "../services/latency_trace.h"
+#include "../services/power.h"
+#include "../services/settings.h"
+#include "../services/glance.h"
+#include "endurance.h"
+#include "navlog.h"
+#include "battery.h"
+
+#define MISSION_MAX_SECTORS 8
+#define MISSION_HISTORY_SIZE 16
+// The mission is not kept across launches: a glance left by an app closed
+// before on block must not count up forever
+#define GLANCE_EXPIRY (12 * SECONDS_PER_HOUR)
 
 static TextLayer *s_main_label;
-static TextLayer *s_main_count;
-static Layer *s_main_count_layer;
+static Layer *s_main_count;
 static TextLayer *s_live_indicator;
 static Layer *s_layer_live_indicator;
 
@@ -23,9 +41,28 @@ typedef struct Info {
 } info_t;
 
 typedef enum Phase_type {
-  PREFLIGHT, TAXI_DEP, INFLIGHT, TAXI_ARR, POSTFLIGHT
+  PREFLIGHT, TAXI_DEP, INFLIGHT, TAXI_ARR, POSTFLIGHT, PHASE_COUNT
 } phase_type_t;
 
+typedef enum Trigger {
+  TRIGGER_NEXT, TRIGGER_TOUCH_AND_GO, TRIGGER_COUNT
+} trigger_t;
+
+// The day is kept in a ring
+static sector_t s_sectors[MISSION_MAX_SECTORS];
+static uint16_t s_sector_count = 1;
+
+// One transition taken, with the sector as it was before so it can be undone
+typedef struct Step {
+  sector_t sector;
+  uint8_t from;
+  uint8_t trigger;
+} step_t;
+
+static step_t s_history[MISSION_HISTORY_SIZE];
+static uint16_t s_history_top = 0;
+static uint8_t s_history_count = 0;
+
 static info_t s_info_roll[INFO_COUNT];
 
 typedef struct Phase {
@@ -33,6 +70,7 @@ typedef struct Phase {
   void (*start)(time_t tick);
   void (*cancel)();
   void (*update)(time_t tick);
+  checklist_id_t checklist;
 } phase_t;
 
 static phase_t s_phase_list[PHASE_COUNT];
@@ -46,7 +84,34 @@ static void switch_to_default(void *data);
 
 static void change_display() {
   text_layer_set_text(s_main_label, s_info_roll[s_current_info_cat].name);
-  text_layer_set_text(s_main_count, s_info_roll[s_current_info_cat].buf);
+  digit_layer_set_text(s_main_count, s_info_roll[s_current_info_cat].buf);
+}
+
+static sector_t *current_sector() {
+  return &s_sectors[(s_sector_count - 1) % MISSION_MAX_SECTORS];
+}
+
+static void set_stamp(info_cat_t cat, time_t tick) {
+  s_info_roll[cat].timestamp = tick;
+  format_time_hhmm(tick, s_info_roll[cat].buf, sizeof(s_info_roll[cat].buf));
+  s_info_roll[cat].active = true;
+}
+
+// Last landing and landing count, from the current sector
+static void show_landings() {
+  sector_t *sector = current_sector();
+  if (sector->landing != 0) {
+    set_stamp(LANDING, sector->landing);
+  } else {
+    s_info_roll[LANDING].active = false;
+  }
+  snprintf(s_info_roll[LANDINGS].buf, sizeof(s_info_roll[LANDINGS].buf), "%d", sector->landings);
+  s_info_roll[LANDINGS].active = sector->landings > 0;
+}
+
+static void set_landed_colors(bool landed) {
+  digit_layer_set_background_color(s_main_count, landed ? GColorWhite : GColorClear);
+  digit_layer_set_text_color(s_main_count, landed ? GColorBlack : GColorWhite);
 }
 
 /* -------------------------------------------------------------
@@ -59,41 +124,46 @@ static phase_t s_preflight = {
   .next = NULL,
   .start = NULL,
   .update = NULL,
-  .cancel = NULL
+  .cancel = NULL,
+  .checklist = CHECKLIST_PREFLIGHT
 };
 
 // Departure taxi phase definition
 
 static void taxi_dep_reminder(void *data) {
-  vibes_short_pulse();
-  s_vibes_timer = app_timer_register(30000, taxi_dep_reminder, NULL);
+  power_vibe(VIBE_REMINDER);
+  s_vibes_timer = app_timer_register(settings_get_ms(SETTING_TAXI_OUT_REMINDER), taxi_dep_reminder, NULL);
 }
 
 static void taxi_dep_start(time_t tick) {
-  s_info_roll[OFF_BLOCK].timestamp = tick;
-  format_time_hhmm(tick, s_info_roll[OFF_BLOCK].buf, sizeof(s_info_roll[OFF_BLOCK].buf));
-  s_info_roll[OFF_BLOCK].active = true;
-  s_vibes_timer = app_timer_register(30000, taxi_dep_reminder, NULL);
+  current_sector()->off_block = tick;
+  set_stamp(OFF_BLOCK, tick);
+  s_vibes_timer = app_timer_register(settings_get_ms(SETTING_TAXI_OUT_REMINDER), taxi_dep_reminder, NULL);
+  heap_guard_arm();
+  battery_check_forecast();
   
   s_current_info_cat = OFF_BLOCK;
-  s_display_timer = app_timer_register(3000, switch_to_default, NULL);
+  s_display_timer = app_timer_register(settings_get_ms(SETTING_INFO_REVERT), switch_to_default, NULL);
   change_display();
+  
+  checklist_window_push(CHECKLIST_BEFORE_TAKEOFF);
 }
 
 static void taxi_dep_update(time_t tick) {
   static bool tick_tock = false;
   tick_tock = !tick_tock;
-  layer_set_hidden(s_main_count_layer, tick_tock);
+  layer_set_hidden(s_main_count, tick_tock);
 }
 
 static void taxi_dep_next() {
-  layer_set_hidden(s_main_count_layer, false);
+  layer_set_hidden(s_main_count, false);
   app_timer_cancel(s_vibes_timer);
 }
 
 static void taxi_dep_cancel() {
   s_info_roll[OFF_BLOCK].active = false;
-  layer_set_hidden(s_main_count_layer, false);
+  heap_guard_disarm();
+  layer_set_hidden(s_main_count, false);
   app_timer_cancel(s_vibes_timer);
 }
 
@@ -101,7 +171,8 @@ static phase_t s_taxi_dep = {
   .next = &taxi_dep_next,
   .start = &taxi_dep_start,
   .update = &taxi_dep_update,
-  .cancel = &taxi_dep_cancel
+  .cancel = &taxi_dep_cancel,
+  .checklist = CHECKLIST_BEFORE_TAKEOFF
 };
 
 // In-flight phase definitions
@@ -113,7 +184,12 @@ static void ft_update(time_t tick) {
   tick_tock = !tick_tock;
   layer_set_hidden(s_layer_live_indicator, tick_tock);
   
-  if (s_info_roll[ENDURANCE].active && s_info_roll[ENDURANCE].timestamp < 45 * SECONDS_PER_MINUTE) {
+  time_t arrival_margin;
+  bool reserve_low = s_info_roll[ENDURANCE].active
+    && (s_info_roll[ENDURANCE].timestamp < settings_get(SETTING_FUEL_RESERVE)
+        || (navlog_get_arrival_margin(&arrival_margin) && arrival_margin < settings_get(SETTING_FUEL_RESERVE)));
+  
+  if (reserve_low) {
     if (!alarm_is_active(ALARM_ENDURANCE)) {
       alarm_display(ALARM_ENDURANCE);
       s_default_info_cat = ENDURANCE;
@@ -131,14 +207,13 @@ static void ft_update(time_t tick) {
 }
 
 static void ft_start(time_t tick) {
-  s_info_roll[TAKE_OFF].timestamp = tick;
-  format_time_hhmm(tick, s_info_roll[TAKE_OFF].buf, sizeof(s_info_roll[TAKE_OFF].buf));
-  s_info_roll[TAKE_OFF].active = true;
+  current_sector()->take_off = tick;
+  set_stamp(TAKE_OFF, tick);
   alarm_start(ALARM_CRUISE_CHECK);
   
   s_current_info_cat = TAKE_OFF;
   s_default_info_cat = FLIGHT_TIME;
-  s_display_timer = app_timer_register(3000, switch_to_default, NULL);
+  s_display_timer = app_timer_register(settings_get_ms(SETTING_INFO_REVERT), switch_to_default, NULL);
   change_display();
 }
 
@@ -162,52 +237,52 @@ static phase_t s_inflight = {
   .next = &ft_next,
   .start = &ft_start,
   .cancel = &ft_cancel,
-  .update = &ft_update
+  .update = &ft_update,
+  .checklist = CHECKLIST_CRUISE
 };
 
 // Arrival taxi phase definitions
 
 static void taxi_arr_reminder(void *data) {
-  vibes_short_pulse();
-  s_vibes_timer = app_timer_register(60000, taxi_arr_reminder, NULL);
+  power_vibe(VIBE_REMINDER);
+  s_vibes_timer = app_timer_register(settings_get_ms(SETTING_TAXI_IN_REMINDER), taxi_arr_reminder, NULL);
 }
 
 static void taxi_arr_start(time_t tick) {
-  s_info_roll[LANDING].timestamp = tick;
-  format_time_hhmm(tick, s_info_roll[LANDING].buf, sizeof(s_info_roll[LANDING].buf));
+  sector_t *sector = current_sector();
+  sector->landing = tick;
+  sector->landings++;
+  show_landings();
   
-  time_t flight_time = s_info_roll[LANDING].timestamp - s_info_roll[TAKE_OFF].timestamp;
+  time_t flight_time = sector->landing - sector->take_off;
   format_duration_hhmm(flight_time, s_info_roll[FLIGHT_TIME].buf, sizeof(s_info_roll[FLIGHT_TIME].buf));
   
-  s_info_roll[LANDING].active = true;
   s_current_info_cat = LANDING;
   s_default_info_cat = LANDING;
-  text_layer_set_background_color(s_main_count, GColorWhite);
-  text_layer_set_text_color(s_main_count, GColorBlack);
+  set_landed_colors(true);
   app_timer_cancel(s_display_timer);
   change_display();
   
-  s_vibes_timer = app_timer_register(60000, taxi_arr_reminder, NULL);
+  s_vibes_timer = app_timer_register(settings_get_ms(SETTING_TAXI_IN_REMINDER), taxi_arr_reminder, NULL);
 }
 
 static void taxi_arr_update(time_t tick) {
   static bool tick_tock = false;
   tick_tock = !tick_tock;
-  layer_set_hidden(s_main_count_layer, tick_tock);
+  layer_set_hidden(s_main_count, tick_tock);
 }
 
 static void taxi_arr_next() {
-  layer_set_hidden(s_main_count_layer, false);
+  layer_set_hidden(s_main_count, false);
   app_timer_cancel(s_vibes_timer);
 }
 
 static void taxi_arr_cancel() {
   s_info_roll[LANDING].active = false;
   s_default_info_cat = FLIGHT_TIME;
-  text_layer_set_background_color(s_main_count, GColorClear);
-  text_layer_set_text_color(s_main_count, GColorWhite);
+  set_landed_colors(false);
   app_timer_cancel(s_display_timer);
-  layer_set_hidden(s_main_count_layer, false);
+  layer_set_hidden(s_main_count, false);
   change_display();
   
   app_timer_cancel(s_vibes_timer);
@@ -217,40 +292,180 @@ static phase_t s_taxi_arr = {
   .next = &taxi_arr_next,
   .start = &taxi_arr_start,
   .cancel = &taxi_arr_cancel,
-  .update = &taxi_arr_update
+  .update = &taxi_arr_update,
+  .checklist = CHECKLIST_NONE
 };
 
 // Post-flight phase definition
 
+static void log_flight() {
+  sector_t *sector = current_sector();
+  flight_t flight = {
+    .off_block = sector->off_block,
+    .take_off = sector->take_off,
+    .landing = sector->landing,
+    .on_block = sector->on_block,
+    .endurance = sector->endurance / SECONDS_PER_MINUTE,
+    .night = FLIGHT_NIGHT_UNKNOWN,
+    .landings = sector->landings
+  };
+  
+  // Without a plan for this sector the idents stay empty and the night unknown
+  const flight_plan_t *plan = sector->planned ? flight_plan_get() : NULL;
+  if (plan != NULL) {
+    const char *destination = plan->legs[plan->leg_count - 1].waypoint;
+    strncpy(flight.departure, plan->departure, sizeof(flight.departure));
+    strncpy(flight.destination, destination, sizeof(flight.destination));
+    
+    time_t night = sun_night_time(plan->departure, destination, flight.off_block, flight.on_block);
+    if (night >= 0) {
+      flight.night = night / SECONDS_PER_MINUTE;
+    }
+  }
+  logbook_append(&flight);
+}
+
 static void postflight_start(time_t tick) {
-  s_info_roll[ON_BLOCK].timestamp = tick;
-  format_time_hhmm(tick, s_info_roll[ON_BLOCK].buf, sizeof(s_info_roll[ON_BLOCK].buf));
-  s_info_roll[ON_BLOCK].active = true;
+  current_sector()->on_block = tick;
+  current_sector()->endurance = endurance_get_takeoff_value();
+  set_stamp(ON_BLOCK, tick);
   
   time_t flight_time = s_info_roll[ON_BLOCK].timestamp - s_info_roll[OFF_BLOCK].timestamp;
   format_duration_hhmm(flight_time, s_info_roll[BLOCK_TIME].buf, sizeof(s_info_roll[BLOCK_TIME].buf));
   s_info_roll[BLOCK_TIME].active = true;
   
   s_current_info_cat = ON_BLOCK;
-  s_display_timer = app_timer_register(3000, switch_to_default, NULL);
+  s_display_timer = app_timer_register(settings_get_ms(SETTING_INFO_REVERT), switch_to_default, NULL);
   change_display();
   
   alarm_start(ALARM_FLIGHT_PLAN);
+  current_sector()->planned = flight_plan_is_loaded();
+  log_flight();
+  if (current_sector()->planned) {
+    flight_plan_set_used(true);
+  }
+  heap_guard_disarm();
 }
 
 static void postflight_cancel() {
   s_info_roll[ON_BLOCK].active = false;
   s_info_roll[BLOCK_TIME].active = false;
   alarm_stop(ALARM_FLIGHT_PLAN);
+  logbook_drop_last();
+  if (current_sector()->planned) {
+    flight_plan_set_used(false);
+  }
+  heap_guard_arm();
 }
 
 static phase_t s_postflight = {
   .next = NULL,
   .start = &postflight_start,
   .update = NULL,
-  .cancel = &postflight_cancel
+  .cancel = &postflight_cancel,
+  .checklist = CHECKLIST_NONE
 };
 
+/* -------------------------------------------------------------
+                Transitions between phases
+   ------------------------------------------------------------- */
+
+// Touch-and-go: counts a landing and stays in flight, flight time runs on
+static void touch_and_go(time_t tick) {
+  sector_t *sector = current_sector();
+  sector->landing = tick;
+  sector->landings++;
+  show_landings();
+  
+  s_current_info_cat = LANDINGS;
+  app_timer_cancel(s_display_timer);
+  s_display_timer = app_timer_register(settings_get_ms(SETTING_INFO_REVERT), switch_to_default, NULL);
+  change_display();
+  power_vibe(VIBE_NOTICE);
+}
+
+// Next sector of the day, from on-block straight to a new off-block
+static void next_sector(time_t tick) {
+  alarm_stop(ALARM_FLIGHT_PLAN);
+  s_sector_count++;
+  *current_sector() = (sector_t) { 0 };
+  
+  s_info_roll[TAKE_OFF].active = false;
+  s_info_roll[ON_BLOCK].active = false;
+  s_info_roll[BLOCK_TIME].active = false;
+  show_landings();
+  s_info_roll[FLIGHT_TIME].timestamp = 0;
+  strcpy(s_info_roll[FLIGHT_TIME].buf, "--:--");
+  s_default_info_cat = FLIGHT_TIME;
+  set_landed_colors(false);
+  
+  taxi_dep_start(tick);
+}
+
+// Back to on-block of the previous sector, whose record is restored by the caller
+static void next_sector_undo() {
+  taxi_dep_cancel();
+  s_sector_count--;
+  
+  sector_t *sector = current_sector();
+  set_stamp(OFF_BLOCK, sector->off_block);
+  set_stamp(TAKE_OFF, sector->take_off);
+  set_stamp(ON_BLOCK, sector->on_block);
+  format_duration_hhmm(sector->landing - sector->take_off, s_info_roll[FLIGHT_TIME].buf, sizeof(s_info_roll[FLIGHT_TIME].buf));
+  s_info_roll[BLOCK_TIME].active = true;
+  format_duration_hhmm(sector->on_block - sector->off_block, s_info_roll[BLOCK_TIME].buf, sizeof(s_info_roll[BLOCK_TIME].buf));
+  s_default_info_cat = LANDING;
+  set_landed_colors(true);
+  alarm_start(ALARM_FLIGHT_PLAN);
+  heap_guard_disarm();
+}
+
+typedef struct Transition {
+  bool allowed;
+  phase_type_t to;
+  // Replaces leaving the current phase and starting the next one
+  void (*action)(time_t tick);
+  // Replaces the cancel of the phase reached
+  void (*undo)();
+} transition_t;
+
+static const transition_t s_transitions[PHASE_COUNT][TRIGGER_COUNT] = {
+  [PREFLIGHT] = {
+    [TRIGGER_NEXT] = { .allowed = true, .to = TAXI_DEP }
+  },
+  [TAXI_DEP] = {
+    [TRIGGER_NEXT] = { .allowed = true, .to = INFLIGHT }
+  },
+  [INFLIGHT] = {
+    [TRIGGER_NEXT] = { .allowed = true, .to = TAXI_ARR },
+    [TRIGGER_TOUCH_AND_GO] = { .allowed = true, .to = INFLIGHT, .action = touch_and_go }
+  },
+  [TAXI_ARR] = {
+    [TRIGGER_NEXT] = { .allowed = true, .to = POSTFLIGHT }
+  },
+  [POSTFLIGHT] = {
+    [TRIGGER_NEXT] = { .allowed = true, .to = TAXI_DEP, .action = next_sector, .undo = next_sector_undo }
+  }
+};
+
+static void history_push(step_t step) {
+  s_history[s_history_top % MISSION_HISTORY_SIZE] = step;
+  s_history_top++;
+  if (s_history_count < MISSION_HISTORY_SIZE) {
+    s_history_count++;
+  }
+}
+
+static bool history_pop(step_t *step) {
+  if (s_history_count == 0) {
+    return false;
+  }
+  s_history_top--;
+  s_history_count--;
+  *step = s_history[s_history_top % MISSION_HISTORY_SIZE];
+  return true;
+}
+
 /* -------------------------------------------------------------
               Display and update logic
    ------------------------------------------------------------- */
@@ -261,7 +476,8 @@ static void init_info_item(info_cat_t cat, const char *title) {
   s_info_roll[cat].timestamp = 0;
 }
 
-void mission_init(Layer *window_layer, GRect bounds) {
+// The state only, before the main window exists
+void mission_init() {
   s_phase_list[PREFLIGHT] = s_preflight;
   s_phase_list[TAXI_DEP] = s_taxi_dep;
   s_phase_list[INFLIGHT] = s_inflight;
@@ -273,19 +489,26 @@ void mission_init(Layer *window_layer, GRect bounds) {
   strcpy(s_info_roll[FLIGHT_TIME].buf, "--:--");
   
   init_info_item(ENDURANCE, "EN");
+  init_info_item(LEG_TIME, "LG");
+  init_info_item(ETA, "EA");
   init_info_item(BLOCK_TIME, "BT");
   init_info_item(OFF_BLOCK, "OF");
   init_info_item(TAKE_OFF, "TO");
   init_info_item(LANDING, "LD");
+  init_info_item(LANDINGS, "NL");
   init_info_item(ON_BLOCK, "ON");
   
-  s_main_label = configure_text_layer(window_layer, GRect(0, 60, bounds.size.w, 44), fonts_get_system_font(FONT_KEY_BITHAM_42_LIGHT), GTextAlignmentLeft);
-  s_main_count = configure_text_layer(window_layer, GRect(bounds.size.w * 0.47, 73, bounds.size.w * 0.53, 30), fonts_get_system_font(FONT_KEY_DROID_SERIF_28_BOLD), GTextAlignmentRight);
-  s_main_count_layer = text_layer_get_layer(s_main_count);
+  // Whatever the last run left in the launcher is over
+  glance_publish(NULL, 0);
+}
+
+void mission_create(Layer *window_layer) {
+  s_main_label = configure_text_layer(window_layer, LAYOUT_INFO_LABEL, fonts_get_system_font(FONT_KEY_BITHAM_42_LIGHT), GTextAlignmentLeft);
+  s_main_count = configure_digit_layer(window_layer, LAYOUT_INFO_VALUE, digit_font_get(DIGIT_FONT_MEDIUM), GTextAlignmentRight);
   
   change_display();
   
-  s_live_indicator = configure_text_layer(window_layer, GRect(bounds.size.w * 0.50, 65, bounds.size.w * 0.50, 9), fonts_get_system_font(FONT_KEY_GOTHIC_09), GTextAlignmentCenter);
+  s_live_indicator = configure_text_layer(window_layer, LAYOUT_INFO_LIVE, fonts_get_system_font(FONT_KEY_GOTHIC_09), GTextAlignmentCenter);
   text_layer_set_text(s_live_indicator, "in flight");
   s_layer_live_indicator = text_layer_get_layer(s_live_indicator);
   layer_set_hidden(s_layer_live_indicator, true);
@@ -293,28 +516,103 @@ void mission_init(Layer *window_layer, GRect bounds) {
 
 void mission_destroy() {
   text_layer_destroy(s_main_label);
-  text_layer_destroy(s_main_count);
+  digit_layer_destroy(s_main_count);
   text_layer_destroy(s_live_indicator);
 }
 
 void mission_update(time_t tick) {
+  heap_guard_check();
   if (s_phase_list[s_current_phase].update != NULL) {
     s_phase_list[s_current_phase].update(tick);
   }
 }
 
-void mission_next() {
-  time_t tick = time(NULL);
-  if (s_current_phase < PHASE_COUNT - 1) {
+// The launcher glance follows the phase. The elapsed and remaining times are
+// templates worked out by the system, nothing is published between phases.
+static void publish_glance() {
+  const sector_t *sector = current_sector();
+  glance_slice_t slices[GLANCE_MAX_SLICES];
+  memset(slices, 0, sizeof(slices));
+  uint8_t count = 0;
+  char hhmm[6];
+  
+  switch (s_current_phase) {
+    case TAXI_DEP:
+      format_time_hhmm(sector->off_block, hhmm, sizeof(hhmm));
+      slices[count].expiration = sector->off_block + GLANCE_EXPIRY;
+      snprintf(slices[count++].subtitle, GLANCE_SUBTITLE_SIZE, "Off block %sZ, taxi {time_since(%ld)|format('%%aT')}",
+               hhmm, (long)sector->off_block);
+      break;
+    case INFLIGHT: {
+      format_time_hhmm(sector->take_off, hhmm, sizeof(hhmm));
+      time_t dry = endurance_get_takeoff_value() != 0 ? sector->take_off + endurance_get_takeoff_value() : 0;
+      if (dry > time(NULL)) {
+        slices[count].expiration = dry;
+        snprintf(slices[count++].subtitle, GLANCE_SUBTITLE_SIZE, "T/O %sZ, EN {time_until(%ld)|format('%%aT')}",
+                 hhmm, (long)dry);
+      }
+      slices[count].expiration = sector->take_off + GLANCE_EXPIRY;
+      snprintf(slices[count++].subtitle, GLANCE_SUBTITLE_SIZE, "T/O %sZ, FT {time_since(%ld)|format('%%aT')}",
+               hhmm, (long)sector->take_off);
+      break;
+    }
+    case TAXI_ARR:
+      format_time_hhmm(sector->landing, hhmm, sizeof(hhmm));
+      slices[count].expiration = sector->landing + GLANCE_EXPIRY;
+      snprintf(slices[count++].subtitle, GLANCE_SUBTITLE_SIZE, "Landed %sZ, FT %s", hhmm, s_info_roll[FLIGHT_TIME].buf);
+      break;
+    case POSTFLIGHT:
+      format_time_hhmm(sector->on_block, hhmm, sizeof(hhmm));
+      slices[count].expiration = sector->on_block + GLANCE_EXPIRY;
+      snprintf(slices[count++].subtitle, GLANCE_SUBTITLE_SIZE, "On block %sZ, BT %s", hhmm, s_info_roll[BLOCK_TIME].buf);
+      break;
+    default:
+      break;
+  }
+  glance_publish(slices, count);
+}
+
+static void fire(trigger_t trigger) {
+  const transition_t *transition = &s_transitions[s_current_phase][trigger];
+  if (!transition->allowed) {
+    return;
+  }
+  
+  time_t tick = time_rounded();
+  history_push((step_t) { .sector = *current_sector(), .from = s_current_phase, .trigger = trigger });
+  
+  if (transition->action != NULL) {
+    s_current_phase = transition->to;
+    transition->action(tick);
+  } else {
     if (s_phase_list[s_current_phase].next != NULL) {
       s_phase_list[s_current_phase].next();
     }
-    s_current_phase++;
+    s_current_phase = transition->to;
     if (s_phase_list[s_current_phase].start != NULL) {
       s_phase_list[s_current_phase].start(tick);
-      mission_update(tick);
     }
   }
+  
+  if (trigger == TRIGGER_TOUCH_AND_GO) {
+    telemetry_log(EVENT_TOUCH_AND_GO, current_sector()->landings);
+  } else {
+    telemetry_log(EVENT_PHASE_NEXT, s_current_phase);
+  }
+  mission_update(tick);
+  if (trigger == TRIGGER_NEXT) {
+    publish_glance();
+  }
+  timeline_window_invalidate();
+  latency_trace_state();
+}
+
+void mission_next() {
+  fire(TRIGGER_NEXT);
+}
+
+void mission_touch_and_go() {
+  fire(TRIGGER_TOUCH_AND_GO);
 }
 
 static void switch_to_default(void *data) {
@@ -323,17 +621,29 @@ static void switch_to_default(void *data) {
 }
 
 void mission_previous() {
-  if (s_phase_list[s_current_phase].cancel == NULL) {
+  step_t step;
+  if (!history_pop(&step)) {
     return;
   }
   
-  s_phase_list[s_current_phase].cancel();
-  s_current_phase--;
+  const transition_t *transition = &s_transitions[step.from][step.trigger];
+  if (transition->undo != NULL) {
+    transition->undo();
+  } else if (transition->action == NULL && s_phase_list[s_current_phase].cancel != NULL) {
+    s_phase_list[s_current_phase].cancel();
+  }
+  s_current_phase = step.from;
+  *current_sector() = step.sector;
+  show_landings();
+  telemetry_log(EVENT_PHASE_CANCEL, s_current_phase);
   if (!s_info_roll[s_current_info_cat].active) {
     app_timer_cancel(s_display_timer);
     switch_to_default(NULL);
   }
   mission_update(time(NULL));
+  publish_glance();
+  timeline_window_invalidate();
+  latency_trace_state();
 }
 
 void mission_switch_display(bool to_flight_time) {
@@ -352,12 +662,29 @@ void mission_switch_display(bool to_flight_time) {
   s_current_info_cat = next;
   
   change_display();
+  latency_trace_state();
   
   if (s_current_info_cat != s_default_info_cat) {
-    s_display_timer = app_timer_register(10000, switch_to_default, NULL);
+    s_display_timer = app_timer_register(settings_get_ms(SETTING_INFO_BROWSE_REVERT), switch_to_default, NULL);
   }
 }
 
+checklist_id_t mission_get_checklist() {
+  return s_phase_list[s_current_phase].checklist;
+}
+
+bool mission_is_in_flight() {
+  return s_current_phase == INFLIGHT;
+}
+
+uint8_t mission_get_sector_count() {
+  return s_sector_count < MISSION_MAX_SECTORS ? s_sector_count : MISSION_MAX_SECTORS;
+}
+
+const sector_t *mission_get_sector(uint8_t index) {
+  return &s_sectors[(s_sector_count - mission_get_sector_count() + index) % MISSION_MAX_SECTORS];
+}
+
 time_t mission_get_timestamp(info_cat_t category) {
   info_t info = s_info_roll[category];
   return info.active ? info.timestamp : 0;
@@ -1,19 +1,39 @@
 #pragma once
 #include <pebble.h>
-#define INFO_COUNT 7
+#include "../services/checklist.h"
+#define INFO_COUNT 10
 #define INFO_BUFFER_SIZE 6
 
 typedef enum Info_category {
-  FLIGHT_TIME, ENDURANCE, BLOCK_TIME, OFF_BLOCK, TAKE_OFF, LANDING, ON_BLOCK
+  FLIGHT_TIME, ENDURANCE, LEG_TIME, ETA, BLOCK_TIME, OFF_BLOCK, TAKE_OFF, LANDING, LANDINGS, ON_BLOCK
 } info_cat_t;
 
-void mission_init(Layer *window_layer, GRect bounds);
+// Block times of one sector (leg of the day), 0 until reached
+typedef struct Sector {
+  time_t off_block;
+  time_t take_off; // first take-off
+  time_t landing; // last landing, touch-and-go or full stop
+  time_t on_block;
+  time_t endurance; // at take-off, recorded at on-block
+  uint8_t landings;
+  bool planned; // flown on the flight plan, which it used up at on-block
+} sector_t;
+
+void mission_init();
+void mission_create(Layer *window_layer);
 void mission_destroy();
 
 void mission_update(time_t tick);
 void mission_next();
+void mission_touch_and_go();
 void mission_previous();
 void mission_switch_display(bool to_flight_time);
+checklist_id_t mission_get_checklist();
+bool mission_is_in_flight();
+
+// The sectors of the day still kept, oldest first, the last one is current
+uint8_t mission_get_sector_count();
+const sector_t *mission_get_sector(uint8_t index);
 
 time_t mission_get_timestamp(info_cat_t category);
 void mission_set_timestamp(info_cat_t category, time_t timestamp);
@@ -0,0 +1,186 @@
+#include <pebble.h>
+#include "navlog.h"
+#include "mission.h"
+#include "endurance.h"
+#include "et.h"
+#include "../windows/timeline_window.h"
+#include "../utils.h"
+#include "../services/flight_plan.h"
+#include "../services/telemetry.h"
+#include "../services/latency_trace.h"
+#include "../services/power.h"
+
+// Navigation log for the loaded flight plan. Up timestamps the crossing of
+// the next waypoint, a long press on Up undoes the last one. The ETAs only move when a
+// crossing changes the actual-vs-planned delta, or while the current leg
+// runs late, so the work per tick is a few subtractions.
+
+static bool s_enabled = true;
+static bool s_running = false;
+static time_t s_takeoff = 0; // take-off the log was started for, kept while paused
+static uint8_t s_leg = 0; // leg being flown, leg_count once at destination
+static time_t s_crossings[FLIGHT_PLAN_MAX_LEGS];
+static time_t s_planned_total = 0;
+static time_t s_delta = 0; // actual minus planned over the legs flown
+static time_t s_leg_eta = 0;
+static time_t s_destination_eta = 0;
+static time_t s_displayed_eta = 0;
+static bool s_leg_end_notified = false;
+
+static time_t leg_start(uint8_t leg) {
+  return leg == 0 ? s_takeoff : s_crossings[leg - 1];
+}
+
+static void update_etas() {
+  const flight_plan_t *plan = flight_plan_get();
+  s_destination_eta = s_takeoff + s_planned_total + s_delta;
+  s_leg_eta = s_leg < plan->leg_count ? leg_start(s_leg) + plan->legs[s_leg].planned : s_destination_eta;
+  s_leg_end_notified = s_leg >= plan->leg_count;
+}
+
+// The planned total and the delta over the crossings kept, against the
+// legs of the plan now loaded
+static void replan() {
+  const flight_plan_t *plan = flight_plan_get();
+  if (s_leg > plan->leg_count) {
+    s_leg = plan->leg_count;
+  }
+  s_planned_total = 0;
+  for (int i = 0; i < plan->leg_count; i++) {
+    s_planned_total += plan->legs[i].planned;
+  }
+  s_delta = 0;
+  for (int i = 0; i < s_leg; i++) {
+    s_delta += s_crossings[i] - leg_start(i) - plan->legs[i].planned;
+  }
+  s_displayed_eta = 0;
+  update_etas();
+}
+
+// A new take-off starts the log over, the same one picks it up where it was
+// paused with its crossings
+static void start(time_t takeoff) {
+  if (takeoff != s_takeoff) {
+    s_takeoff = takeoff;
+    s_leg = 0;
+  }
+  s_running = true;
+  replan();
+  mission_set_status(LEG_TIME, true);
+  mission_set_status(ETA, true);
+}
+
+static void stop() {
+  s_running = false;
+  mission_set_status(LEG_TIME, false);
+  mission_set_status(ETA, false);
+}
+
+// Destination ETA, pushed back by however late the current leg is running
+static time_t effective_destination_eta(time_t tick) {
+  return tick > s_leg_eta ? s_destination_eta + tick - s_leg_eta : s_destination_eta;
+}
+
+// Starts or stops the log following the mission, returns whether it runs
+static bool sync() {
+  if (!navlog_is_active()) {
+    if (s_running) {
+      stop();
+    }
+    return false;
+  }
+  
+  time_t takeoff = mission_get_timestamp(TAKE_OFF);
+  if (!s_running || takeoff != s_takeoff) {
+    start(takeoff);
+  }
+  return true;
+}
+
+void navlog_update(time_t tick) {
+  if (!sync()) {
+    return;
+  }
+  
+  time_t remaining = s_leg_eta > tick ? s_leg_eta - tick : 0;
+  format_duration_mmss(remaining, mission_get_info_buffer(LEG_TIME), INFO_BUFFER_SIZE);
+  if (remaining == 0 && !s_leg_end_notified) {
+    s_leg_end_notified = true;
+    power_vibe(VIBE_NOTICE);
+  }
+  
+  time_t eta = effective_destination_eta(tick);
+  mission_set_timestamp(ETA, eta);
+  if (eta / SECONDS_PER_MINUTE != s_displayed_eta / SECONDS_PER_MINUTE) {
+    s_displayed_eta = eta;
+    format_time_hhmm(eta, mission_get_info_buffer(ETA), INFO_BUFFER_SIZE);
+  }
+}
+
+bool navlog_next() {
+  const flight_plan_t *plan = flight_plan_get();
+  if (!sync() || s_leg >= plan->leg_count) {
+    return false;
+  }
+  
+  time_t tick = time(NULL);
+  s_crossings[s_leg] = tick;
+  s_delta += tick - leg_start(s_leg) - plan->legs[s_leg].planned;
+  s_leg++;
+  update_etas();
+  telemetry_log(EVENT_WAYPOINT, s_leg);
+  timeline_window_invalidate();
+  
+  elapsed_time_flyback();
+  navlog_update(tick);
+  return true;
+}
+
+bool navlog_previous() {
+  if (!sync() || s_leg == 0) {
+    return false;
+  }
+  
+  s_leg--;
+  s_delta -= s_crossings[s_leg] - leg_start(s_leg) - flight_plan_get()->legs[s_leg].planned;
+  update_etas();
+  timeline_window_invalidate();
+  navlog_update(time(NULL));
+  power_vibe(VIBE_NOTICE);
+  latency_trace_state();
+  return true;
+}
+
+// A touch-and-go records a landing but stays in flight, the phase tells
+bool navlog_is_active() {
+  return s_enabled && flight_plan_is_loaded() && mission_is_in_flight();
+}
+
+void navlog_plan_changed() {
+  if (s_running && flight_plan_is_loaded()) {
+    replan();
+    timeline_window_invalidate();
+  }
+}
+
+bool navlog_is_enabled() {
+  return s_enabled;
+}
+
+void navlog_set_enabled(bool enabled) {
+  s_enabled = enabled;
+}
+
+// Endurance left when reaching the destination at the current ETA
+bool navlog_get_arrival_margin(time_t *margin) {
+  if (!s_running || endurance_get_takeoff_value() == 0) {
+    return false;
+  }
+  *margin = s_takeoff + endurance_get_takeoff_value() - effective_destination_eta(time(NULL));
+  return true;
+}
+
+uint8_t navlog_get_crossings(const time_t **crossings) {
+  *crossings = s_crossings;
+  return s_running ? s_leg : 0;
+}
@@ -0,0 +1,16 @@
+#pragma once
+#include <pebble.h>
+
+void navlog_update(time_t tick);
+bool navlog_next();
+bool navlog_previous();
+
+bool navlog_is_active();
+// A plan received in flight: the ETAs follow its legs, the crossings are kept
+void navlog_plan_changed();
+bool navlog_is_enabled();
+void navlog_set_enabled(bool enabled);
+bool navlog_get_arrival_margin(time_t *margin);
+
+// Crossing times of the waypoints passed since take-off, oldest first
+uint8_t navlog_get_crossings(const time_t **crossings);
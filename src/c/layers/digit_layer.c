@@ -0,0 +1,378 @@
+#include <pebble.h>
+#include "digit_layer.h"
+#include "../services/profile.h"
+
+#define GLYPHS "0123456789:-."
+#define GLYPH_COUNT ((int)sizeof(GLYPHS) - 1)
+#define MAX_ATLASES 3
+
+// Build with -DDIGIT_LAYER_BENCHMARK=1 to log the per-frame cost of the atlas
+// against graphics_draw_text for the same string.
+#ifndef DIGIT_LAYER_BENCHMARK
+#define DIGIT_LAYER_BENCHMARK 0
+#endif
+#define BENCHMARK_ROUNDS 50
+#define BENCHMARK_FRAMES 10
+
+typedef struct DigitAtlas {
+  GFont font;
+  GBitmap *bitmap;
+  uint8_t refs;
+  bool failed;
+  GColor palette[2];
+  int16_t offsets[GLYPH_COUNT + 1]; // x of each glyph, the last one is the atlas width
+} DigitAtlas;
+
+static DigitAtlas s_atlases[MAX_ATLASES];
+
+static int glyph_index(char c) {
+  const char *glyph = strchr(GLYPHS, c);
+  return (glyph != NULL && c != '\0') ? glyph - GLYPHS : -1;
+}
+
+static DigitAtlas *atlas_get(GFont font) {
+  DigitAtlas *free_slot = NULL;
+  for (int i = 0; i < MAX_ATLASES; i++) {
+    if (s_atlases[i].refs > 0 && s_atlases[i].font == font) {
+      s_atlases[i].refs++;
+      return &s_atlases[i];
+    }
+    if (s_atlases[i].refs == 0 && free_slot == NULL) {
+      free_slot = &s_atlases[i];
+    }
+  }
+  if (free_slot != NULL) {
+    *free_slot = (DigitAtlas) { .font = font, .refs = 1 };
+  }
+  return free_slot;
+}
+
+static void atlas_release(DigitAtlas *atlas) {
+  if (atlas == NULL || --atlas->refs > 0) {
+    return;
+  }
+  if (atlas->bitmap != NULL) {
+    gbitmap_destroy(atlas->bitmap);
+    atlas->bitmap = NULL;
+  }
+}
+
+/* -------------------------------------------------------------
+                Rasterization, once per font
+   ------------------------------------------------------------- */
+
+// Byte span of the screen columns [x, x + width) in a frame buffer row
+static void row_span(GBitmapFormat format, int x, int width, int *first, int *count) {
+  if (format == GBitmapFormat1Bit) {
+    *first = x / 8;
+    *count = (x + width - 1) / 8 - *first + 1;
+  } else {
+    *first = x;
+    *count = width;
+  }
+}
+
+static bool pixel_is_lit(GBitmapFormat format, const uint8_t *row, int x) {
+  if (format == GBitmapFormat1Bit) {
+    return (row[x / 8] >> (x % 8)) & 1;
+  }
+  // 8-bit ARGB: glyphs are drawn white on black, anti-aliased edges count
+  // as lit from mid-grey up
+  return ((row[x] >> 2) & 0x3) >= 2;
+}
+
+static void atlas_set_pixel(GBitmap *bitmap, int x, int y) {
+  uint8_t *row = gbitmap_get_data(bitmap) + y * gbitmap_get_bytes_per_row(bitmap);
+#ifdef PBL_COLOR
+  row[x / 8] |= 0x80 >> (x % 8); // palettized formats are MSB first
+#else
+  row[x / 8] |= 1 << (x % 8);
+#endif
+}
+
+static GBitmap *atlas_create_bitmap(DigitAtlas *atlas, GSize size) {
+  GBitmap *bitmap;
+#ifdef PBL_COLOR
+  atlas->palette[0] = GColorClear;
+  atlas->palette[1] = GColorWhite;
+  bitmap = gbitmap_create_blank_with_palette(size, GBitmapFormat1BitPalette, atlas->palette, false);
+  if (bitmap == NULL) {
+    return NULL;
+  }
+#else
+  bitmap = gbitmap_create_blank(size, GBitmapFormat1Bit);
+  if (bitmap == NULL) {
+    return NULL;
+  }
+#endif
+  memset(gbitmap_get_data(bitmap), 0, gbitmap_get_bytes_per_row(bitmap) * size.h);
+  return bitmap;
+}
+
+// Copies the frame buffer area under the layer to or from a buffer, so that
+// rasterizing the glyphs leaves whatever was drawn below untouched.
+static void swap_area(GContext *ctx, GRect area, uint8_t *buffer, bool save) {
+  GBitmap *frame_buffer = graphics_capture_frame_buffer(ctx);
+  if (frame_buffer == NULL) {
+    return;
+  }
+  int first, count;
+  row_span(gbitmap_get_format(frame_buffer), area.origin.x, area.size.w, &first, &count);
+  for (int y = 0; y < area.size.h; y++) {
+    uint8_t *row = gbitmap_get_data_row_info(frame_buffer, area.origin.y + y).data + first;
+    if (save) {
+      memcpy(buffer + y * count, row, count);
+    } else {
+      memcpy(row, buffer + y * count, count);
+    }
+  }
+  graphics_release_frame_buffer(ctx, frame_buffer);
+}
+
+// Each glyph is drawn white on black at the layer's left edge, read back
+// from the frame buffer and copied into the atlas.
+static bool atlas_build(DigitAtlas *atlas, Layer *layer, GContext *ctx) {
+  GRect bounds = layer_get_bounds(layer);
+  GPoint origin = layer_convert_point_to_screen(layer, GPointZero);
+
+  int16_t cell_width = 0;
+  int16_t x = 0;
+  for (int i = 0; i < GLYPH_COUNT; i++) {
+    char glyph[] = { GLYPHS[i], '\0' };
+    GSize size = graphics_text_layout_get_content_size(glyph, atlas->font, bounds, GTextOverflowModeFill, GTextAlignmentLeft);
+    atlas->offsets[i] = x;
+    x += size.w;
+    if (size.w > cell_width) {
+      cell_width = size.w;
+    }
+  }
+  atlas->offsets[GLYPH_COUNT] = x;
+
+  GRect area = GRect(origin.x, origin.y, cell_width, bounds.size.h);
+  GRect screen = layer_get_bounds(window_get_root_layer(layer_get_window(layer)));
+  if (cell_width == 0 || cell_width > bounds.size.w || area.origin.x < 0 || area.origin.y < 0
+      || area.origin.x + area.size.w > screen.size.w || area.origin.y + area.size.h > screen.size.h) {
+    return false;
+  }
+
+  GBitmap *frame_buffer = graphics_capture_frame_buffer(ctx);
+  if (frame_buffer == NULL) {
+    return false;
+  }
+  GBitmapFormat format = gbitmap_get_format(frame_buffer);
+  graphics_release_frame_buffer(ctx, frame_buffer);
+
+  int first, count;
+  row_span(format, area.origin.x, area.size.w, &first, &count);
+  uint8_t *saved = malloc(count * area.size.h);
+  atlas->bitmap = atlas_create_bitmap(atlas, GSize(x, bounds.size.h));
+  if (saved == NULL || atlas->bitmap == NULL) {
+    free(saved);
+    if (atlas->bitmap != NULL) {
+      gbitmap_destroy(atlas->bitmap);
+      atlas->bitmap = NULL;
+    }
+    return false;
+  }
+  swap_area(ctx, area, saved, true);
+
+  GRect cell = GRect(0, 0, cell_width, bounds.size.h);
+  graphics_context_set_text_color(ctx, GColorWhite);
+  graphics_context_set_fill_color(ctx, GColorBlack);
+  for (int i = 0; i < GLYPH_COUNT; i++) {
+    char glyph[] = { GLYPHS[i], '\0' };
+    graphics_fill_rect(ctx, cell, 0, GCornerNone);
+    graphics_draw_text(ctx, glyph, atlas->font, cell, GTextOverflowModeFill, GTextAlignmentLeft, NULL);
+
+    frame_buffer = graphics_capture_frame_buffer(ctx);
+    for (int y = 0; y < area.size.h; y++) {
+      const uint8_t *row = gbitmap_get_data_row_info(frame_buffer, area.origin.y + y).data;
+      for (int gx = 0; gx < atlas->offsets[i + 1] - atlas->offsets[i]; gx++) {
+        if (pixel_is_lit(format, row, area.origin.x + gx)) {
+          atlas_set_pixel(atlas->bitmap, atlas->offsets[i] + gx, y);
+        }
+      }
+    }
+    graphics_release_frame_buffer(ctx, frame_buffer);
+  }
+
+  swap_area(ctx, area, saved, false);
+  free(saved);
+  return true;
+}
+
+/* -------------------------------------------------------------
+                Drawing
+   ------------------------------------------------------------- */
+
+static bool atlas_covers(const DigitAtlas *atlas, const char *text) {
+  if (atlas == NULL || atlas->bitmap == NULL) {
+    return false;
+  }
+  for (const char *c = text; *c != '\0'; c++) {
+    if (glyph_index(*c) < 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static void draw_from_atlas(DigitLayerData *data, GContext *ctx, GRect bounds) {
+  DigitAtlas *atlas = data->atlas;
+
+  int16_t width = 0;
+  for (const char *c = data->text; *c != '\0'; c++) {
+    int i = glyph_index(*c);
+    width += atlas->offsets[i + 1] - atlas->offsets[i];
+  }
+
+  int16_t x = 0;
+  if (data->alignment == GTextAlignmentRight) {
+    x = bounds.size.w - width;
+  } else if (data->alignment == GTextAlignmentCenter) {
+    x = (bounds.size.w - width) / 2;
+  }
+
+  int16_t height = gbitmap_get_bounds(atlas->bitmap).size.h;
+  if (height > bounds.size.h) {
+    height = bounds.size.h;
+  }
+
+#ifdef PBL_COLOR
+  atlas->palette[1] = data->text_color;
+  graphics_context_set_compositing_mode(ctx, GCompOpSet);
+#else
+  graphics_context_set_compositing_mode(ctx, gcolor_equal(data->text_color, GColorBlack) ? GCompOpClear : GCompOpSet);
+#endif
+
+  for (const char *c = data->text; *c != '\0'; c++) {
+    int i = glyph_index(*c);
+    int16_t glyph_width = atlas->offsets[i + 1] - atlas->offsets[i];
+    gbitmap_set_bounds(atlas->bitmap, GRect(atlas->offsets[i], 0, glyph_width, height));
+    graphics_draw_bitmap_in_rect(ctx, atlas->bitmap, GRect(x, 0, glyph_width, height));
+    x += glyph_width;
+  }
+
+  gbitmap_set_bounds(atlas->bitmap, GRect(0, 0, atlas->offsets[GLYPH_COUNT], gbitmap_get_bounds(atlas->bitmap).size.h));
+  graphics_context_set_compositing_mode(ctx, GCompOpAssign);
+}
+
+static void draw_text(DigitLayerData *data, GContext *ctx, GRect bounds) {
+  graphics_context_set_text_color(ctx, data->text_color);
+  graphics_draw_text(ctx, data->text, data->font, bounds, GTextOverflowModeWordWrap, data->alignment, NULL);
+}
+
+#if DIGIT_LAYER_BENCHMARK
+static uint32_t now_ms() {
+  time_t seconds;
+  uint16_t ms;
+  time_ms(&seconds, &ms);
+  return seconds * 1000 + ms;
+}
+
+// Averaged over BENCHMARK_FRAMES frames of BENCHMARK_ROUNDS draws each, the
+// frame is then drawn normally over the result.
+static void benchmark(DigitLayerData *data, GContext *ctx, GRect bounds) {
+  static uint32_t s_atlas_ms, s_text_ms;
+  static int s_frames;
+
+  if (data->text == NULL || !atlas_covers(data->atlas, data->text)) {
+    return;
+  }
+
+  uint32_t start = now_ms();
+  for (int i = 0; i < BENCHMARK_ROUNDS; i++) {
+    draw_text(data, ctx, bounds);
+  }
+  uint32_t middle = now_ms();
+  for (int i = 0; i < BENCHMARK_ROUNDS; i++) {
+    draw_from_atlas(data, ctx, bounds);
+  }
+  s_text_ms += middle - start;
+  s_atlas_ms += now_ms() - middle;
+
+  if (++s_frames == BENCHMARK_FRAMES) {
+    APP_LOG(APP_LOG_LEVEL_DEBUG, "digits '%s': atlas %d us, draw_text %d us per draw", data->text,
+            (int)(s_atlas_ms * 1000 / (BENCHMARK_FRAMES * BENCHMARK_ROUNDS)),
+            (int)(s_text_ms * 1000 / (BENCHMARK_FRAMES * BENCHMARK_ROUNDS)));
+    s_atlas_ms = s_text_ms = 0;
+    s_frames = 0;
+  }
+}
+#endif
+
+static void draw(Layer *layer, GContext *ctx) {
+  DigitLayerData *data = layer_get_data(layer);
+  GRect bounds = layer_get_bounds(layer);
+
+  DigitAtlas *atlas = data->atlas;
+  if (atlas != NULL && atlas->bitmap == NULL && !atlas->failed) {
+    atlas->failed = !atlas_build(atlas, layer, ctx);
+  }
+
+#if DIGIT_LAYER_BENCHMARK
+  benchmark(data, ctx, bounds);
+#endif
+
+  if (!gcolor_equal(data->background_color, GColorClear)) {
+    graphics_context_set_fill_color(ctx, data->background_color);
+    graphics_fill_rect(ctx, bounds, 0, GCornerNone);
+  }
+
+  if (data->text == NULL) {
+    return;
+  }
+  if (atlas_covers(atlas, data->text)) {
+    draw_from_atlas(data, ctx, bounds);
+  } else {
+    draw_text(data, ctx, bounds);
+  }
+}
+
+static void update_proc(Layer *layer, GContext *ctx) {
+  PROFILE_CALL(PROFILE_DRAW_DIGITS, draw(layer, ctx));
+}
+
+/* -------------------------------------------------------------
+                Public interface
+   ------------------------------------------------------------- */
+
+Layer* digit_layer_create(GRect frame, GFont font, GTextAlignment alignment) {
+  Layer *layer = layer_create_with_data(frame, sizeof(DigitLayerData));
+  DigitLayerData *data = layer_get_data(layer);
+
+  *data = (DigitLayerData) {
+    .font = font,
+    .alignment = alignment,
+    .text_color = GColorWhite,
+    .background_color = GColorClear,
+    .atlas = atlas_get(font)
+  };
+
+  layer_set_update_proc(layer, update_proc);
+  return layer;
+}
+
+void digit_layer_destroy(Layer *layer) {
+  DigitLayerData *data = layer_get_data(layer);
+  atlas_release(data->atlas);
+  layer_destroy(layer);
+}
+
+void digit_layer_set_text(Layer *layer, const char *text) {
+  DigitLayerData *data = layer_get_data(layer);
+  data->text = text;
+  layer_mark_dirty(layer);
+}
+
+void digit_layer_set_text_color(Layer *layer, GColor color) {
+  DigitLayerData *data = layer_get_data(layer);
+  data->text_color = color;
+  layer_mark_dirty(layer);
+}
+
+void digit_layer_set_background_color(Layer *layer, GColor color) {
+  DigitLayerData *data = layer_get_data(layer);
+  data->background_color = color;
+  layer_mark_dirty(layer);
+}
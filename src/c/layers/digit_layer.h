@@ -0,0 +1,27 @@
+#pragma once
+
+#include <pebble.h>
+
+// Drop-in replacement for a TextLayer showing a short numeric readout.
+// Digits, ':', '-' and '.' are rasterized once per font into a shared 1-bit atlas
+// on the first frame and blitted from there afterwards. Any other character
+// falls back to graphics_draw_text.
+typedef struct DigitLayerData {
+  GFont font;
+  GTextAlignment alignment;
+  GColor text_color;
+  GColor background_color;
+  const char *text;
+  struct DigitAtlas *atlas;
+} DigitLayerData;
+
+Layer* digit_layer_create(GRect frame, GFont font, GTextAlignment alignment);
+
+void digit_layer_destroy(Layer *layer);
+
+// Like a TextLayer, the text is not copied and must stay valid
+void digit_layer_set_text(Layer *layer, const char *text);
+
+void digit_layer_set_text_color(Layer *layer, GColor color);
+
+void digit_layer_set_background_color(Layer *layer, GColor color);
@@ -0,0 +1,231 @@
+// Numeric entry layer, reworked from the Pebble UI selection layer adapted
+// for modular use by Eric Phillips
+
+#include <pebble.h>
+#include "entry_layer.h"
+#include "../services/profile.h"
+
+// Look and feel
+#define DEFAULT_CELL_PADDING 10
+#define DEFAULT_FONT FONT_KEY_GOTHIC_28_BOLD
+#define DEFAULT_ACTIVE_COLOR GColorWhite
+#define DEFAULT_INACTIVE_COLOR PBL_IF_COLOR_ELSE(GColorDarkGray, GColorBlack)
+
+#define BUTTON_HOLD_REPEAT_MS 100
+// Repeats of a held button before switching to the fast step
+#define FAST_STEP_AFTER_CLICKS 10
+
+// Vertically centers the digits of the known fonts, computed once per font
+static int16_t prv_get_text_y_offset(GFont font, int height) {
+  int font_height = 0;
+  int font_top_padding = 0;
+  if (font == fonts_get_system_font(FONT_KEY_GOTHIC_28_BOLD)) {
+    font_height = 18;
+    font_top_padding = 10;
+  } else if (font == fonts_get_system_font(FONT_KEY_GOTHIC_24_BOLD)) {
+    font_height = 14;
+    font_top_padding = 10;
+  }
+
+  return (height / 2) - (font_height / 2) - font_top_padding;
+}
+
+static const char *prv_get_cell_text(EntryLayerData *data, int index) {
+  EntryCell *cell = &data->cells[index];
+  if (cell->stale) {
+    const EntryField *field = &data->fields[index];
+    // Checked by entry_layer_set_fields, clamped again so the text never overflows
+    int decimals = field->decimals < ENTRY_LAYER_MAX_DIGITS ? field->decimals : ENTRY_LAYER_MAX_DIGITS;
+    int digits = field->digits + decimals <= ENTRY_LAYER_MAX_DIGITS ? field->digits : ENTRY_LAYER_MAX_DIGITS - decimals;
+    if (decimals > 0) {
+      int divisor = 1;
+      for (int i = 0; i < decimals; i++) {
+        divisor *= 10;
+      }
+      uint16_t magnitude = cell->value < 0 ? -cell->value : cell->value;
+      snprintf(cell->text, sizeof(cell->text), "%s%0*d.%0*d", cell->value < 0 ? "-" : "", digits,
+               magnitude / divisor, decimals, magnitude % divisor);
+    } else {
+      snprintf(cell->text, sizeof(cell->text), "%0*d", digits, cell->value);
+    }
+    cell->stale = false;
+  }
+  return cell->text;
+}
+
+static void prv_draw_entry_layer(Layer *layer, GContext *ctx) {
+  EntryLayerData *data = layer_get_data(layer);
+  int height = layer_get_bounds(layer).size.h;
+
+  for (int i = 0, x = 0; i < data->field_count; i++) {
+    int width = data->fields[i].width;
+
+    graphics_context_set_fill_color(ctx, data->selected == i ? data->active_background_color : data->inactive_background_color);
+    graphics_fill_rect(ctx, GRect(x, 0, width, height), 1, GCornerNone);
+
+    graphics_draw_text(ctx, prv_get_cell_text(data, i), data->font, GRect(x, data->text_y_offset, width, height),
+                       GTextOverflowModeFill, GTextAlignmentCenter, NULL);
+
+    x += width + data->cell_padding;
+  }
+}
+
+static void prv_update_proc(Layer *layer, GContext *ctx) {
+  PROFILE_CALL(PROFILE_DRAW_ENTRY, prv_draw_entry_layer(layer, ctx));
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//! Click handlers
+
+static void prv_step(Layer *layer, ClickRecognizerRef recognizer, int direction) {
+  EntryLayerData *data = layer_get_data(layer);
+  const EntryField *field = &data->fields[data->selected];
+  EntryCell *cell = &data->cells[data->selected];
+
+  bool fast = click_number_of_clicks_counted(recognizer) > FAST_STEP_AFTER_CLICKS && field->fast_step > 0;
+  int value = cell->value + direction * (fast ? field->fast_step : field->step);
+
+  // Clamps to the bounds first, wraps around once there
+  if (value > field->max) {
+    value = cell->value == field->max ? field->min : field->max;
+  } else if (value < field->min) {
+    value = cell->value == field->min ? field->max : field->min;
+  }
+
+  cell->value = value;
+  cell->stale = true;
+  layer_mark_dirty(layer);
+}
+
+static void prv_up_click_handler(ClickRecognizerRef recognizer, void *context) {
+  prv_step((Layer*)context, recognizer, 1);
+}
+
+static void prv_down_click_handler(ClickRecognizerRef recognizer, void *context) {
+  prv_step((Layer*)context, recognizer, -1);
+}
+
+static void prv_select_click_handler(ClickRecognizerRef recognizer, void *context) {
+  Layer *layer = (Layer*)context;
+  EntryLayerData *data = layer_get_data(layer);
+
+  if (data->selected >= data->field_count - 1) {
+    data->selected = 0;
+    if (data->callbacks.complete) {
+      data->callbacks.complete(layer, data->context);
+    }
+  } else {
+    data->selected++;
+  }
+  layer_mark_dirty(layer);
+}
+
+static void prv_back_click_handler(ClickRecognizerRef recognizer, void *context) {
+  Layer *layer = (Layer*)context;
+  EntryLayerData *data = layer_get_data(layer);
+
+  if (data->selected == 0) {
+    if (data->callbacks.cancel) {
+      data->callbacks.cancel(data->context);
+    } else {
+      window_stack_pop(true);
+    }
+  } else {
+    data->selected--;
+    layer_mark_dirty(layer);
+  }
+}
+
+static void prv_click_config_provider(Layer *layer) {
+  window_set_click_context(BUTTON_ID_UP, layer);
+  window_set_click_context(BUTTON_ID_DOWN, layer);
+  window_set_click_context(BUTTON_ID_SELECT, layer);
+  window_set_click_context(BUTTON_ID_BACK, layer);
+
+  window_single_repeating_click_subscribe(BUTTON_ID_UP, BUTTON_HOLD_REPEAT_MS, prv_up_click_handler);
+  window_single_repeating_click_subscribe(BUTTON_ID_DOWN, BUTTON_HOLD_REPEAT_MS, prv_down_click_handler);
+  window_single_click_subscribe(BUTTON_ID_SELECT, prv_select_click_handler);
+  window_single_click_subscribe(BUTTON_ID_BACK, prv_back_click_handler);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//! API
+
+Layer* entry_layer_create(GRect frame, uint8_t capacity) {
+  Layer *layer = layer_create_with_data(frame, sizeof(EntryLayerData) + capacity * sizeof(EntryCell));
+  EntryLayerData *data = layer_get_data(layer);
+
+  // Set layer defaults
+  *data = (EntryLayerData) {
+    .active_background_color = DEFAULT_ACTIVE_COLOR,
+    .inactive_background_color = DEFAULT_INACTIVE_COLOR,
+    .capacity = capacity,
+    .cell_padding = DEFAULT_CELL_PADDING,
+  };
+  entry_layer_set_font(layer, fonts_get_system_font(DEFAULT_FONT));
+
+  layer_set_clips(layer, false);
+  layer_set_update_proc(layer, prv_update_proc);
+
+  return layer;
+}
+
+void entry_layer_destroy(Layer *layer) {
+  layer_destroy(layer);
+}
+
+void entry_layer_set_fields(Layer *layer, const EntryField *fields, uint8_t count, const int16_t *values) {
+  EntryLayerData *data = layer_get_data(layer);
+
+  data->fields = fields;
+  data->field_count = count < data->capacity ? count : data->capacity;
+  data->selected = 0;
+  for (int i = 0; i < data->field_count; i++) {
+    if (fields[i].digits + fields[i].decimals > ENTRY_LAYER_MAX_DIGITS) {
+      APP_LOG(APP_LOG_LEVEL_WARNING, "Entry field %d: %d digits shown as %d", i,
+              fields[i].digits + fields[i].decimals, ENTRY_LAYER_MAX_DIGITS);
+    }
+    data->cells[i].value = values[i];
+    data->cells[i].stale = true;
+  }
+  layer_mark_dirty(layer);
+}
+
+int16_t entry_layer_get_value(Layer *layer, uint8_t index) {
+  EntryLayerData *data = layer_get_data(layer);
+  return index < data->field_count ? data->cells[index].value : 0;
+}
+
+void entry_layer_set_font(Layer *layer, GFont font) {
+  EntryLayerData *data = layer_get_data(layer);
+
+  data->font = font;
+  data->text_y_offset = prv_get_text_y_offset(font, layer_get_bounds(layer).size.h);
+}
+
+void entry_layer_set_inactive_bg_color(Layer *layer, GColor color) {
+  EntryLayerData *data = layer_get_data(layer);
+  data->inactive_background_color = color;
+}
+
+void entry_layer_set_active_bg_color(Layer *layer, GColor color) {
+  EntryLayerData *data = layer_get_data(layer);
+  data->active_background_color = color;
+}
+
+void entry_layer_set_cell_padding(Layer *layer, int padding) {
+  EntryLayerData *data = layer_get_data(layer);
+  data->cell_padding = padding;
+}
+
+void entry_layer_set_click_config_onto_window(Layer *layer, struct Window *window) {
+  if (layer && window) {
+    window_set_click_config_provider_with_context(window, (ClickConfigProvider)prv_click_config_provider, layer);
+  }
+}
+
+void entry_layer_set_callbacks(Layer *layer, void *context, EntryLayerCallbacks callbacks) {
+  EntryLayerData *data = layer_get_data(layer);
+  data->callbacks = callbacks;
+  data->context = context;
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <pebble.h>
+
+// Digits of a field, decimals included: an int16_t value never has more
+#define ENTRY_LAYER_MAX_DIGITS 5
+// Sign, the digits on either side of the point, the point and the NUL
+#define ENTRY_LAYER_TEXT_SIZE (2 * ENTRY_LAYER_MAX_DIGITS + 3)
+
+// Describes one field of the entry, values are plain integers.
+typedef struct EntryField {
+  int16_t min;
+  int16_t max;
+  int16_t step;
+  int16_t fast_step; // once the button has been held for a while
+  uint8_t digits; // zero padded to this many digits
+  uint8_t decimals; // fixed point, 1 shows 123 as 12.3, digits + decimals <= ENTRY_LAYER_MAX_DIGITS
+  uint8_t width; // cell width in pixels
+} EntryField;
+
+typedef void (*EntryLayerCompleteCallback)(Layer *layer, void *context);
+
+typedef void (*EntryLayerCancelCallback)(void *context);
+
+typedef struct EntryLayerCallbacks {
+  EntryLayerCompleteCallback complete;
+  EntryLayerCancelCallback cancel;
+} EntryLayerCallbacks;
+
+typedef struct EntryCell {
+  int16_t value;
+  bool stale;
+  char text[ENTRY_LAYER_TEXT_SIZE];
+} EntryCell;
+
+typedef struct EntryLayerData {
+  const EntryField *fields;
+  uint8_t field_count;
+  uint8_t capacity;
+  uint8_t selected;
+
+  GFont font;
+  int16_t text_y_offset;
+  int cell_padding;
+  GColor inactive_background_color;
+  GColor active_background_color;
+
+  EntryLayerCallbacks callbacks;
+  void *context;
+  EntryCell cells[]; // capacity cells, text cached until the value changes
+} EntryLayerData;
+
+// Room for up to capacity fields is allocated with the layer
+Layer* entry_layer_create(GRect frame, uint8_t capacity);
+
+void entry_layer_destroy(Layer *layer);
+
+// Starts a new entry on the first field, the descriptors must stay valid.
+// Fields beyond the layer capacity are ignored.
+void entry_layer_set_fields(Layer *layer, const EntryField *fields, uint8_t count, const int16_t *values);
+
+int16_t entry_layer_get_value(Layer *layer, uint8_t index);
+
+void entry_layer_set_font(Layer *layer, GFont font);
+
+void entry_layer_set_inactive_bg_color(Layer *layer, GColor color);
+
+void entry_layer_set_active_bg_color(Layer *layer, GColor color);
+
+void entry_layer_set_cell_padding(Layer *layer, int padding);
+
+void entry_layer_set_click_config_onto_window(Layer *layer, struct Window *window);
+
+void entry_layer_set_callbacks(Layer *layer, void *context, EntryLayerCallbacks callbacks);
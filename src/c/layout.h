@@ -0,0 +1,85 @@
+#pragma once
+#include <pebble.h>
+
+// Screen positions of the main display and of the dialogs, one table per
+// display, picked at compile time. Every entry is a constant, nothing is
+// worked out from the window bounds at runtime.
+
+#if defined(PBL_PLATFORM_EMERY)
+
+// 200x228, the 144x168 layout spread out with a margin
+#define LAYOUT_CLOCK GRect(6, 8, 188, 44)
+#define LAYOUT_CLOCK_DESC GRect(16, 36, 30, 26)
+#define LAYOUT_BATTERY GRect(0, 72, 200, 3)
+#define LAYOUT_INFO_LABEL GRect(6, 86, 188, 44)
+#define LAYOUT_INFO_VALUE GRect(94, 99, 100, 30)
+#define LAYOUT_INFO_LIVE GRect(100, 91, 94, 9)
+#define LAYOUT_ENDURANCE GRect(0, 142, 200, 12)
+#define LAYOUT_ET_FONT DIGIT_FONT_LARGE
+#define LAYOUT_ET_COUNTER GRect(6, 164, 188, 44)
+#define LAYOUT_ET_START GRect(6, 164, 188, 44)
+#define LAYOUT_ET_DESC GRect(16, 192, 20, 26)
+
+#define LAYOUT_ENTRY_MAIN_INSETS ((GEdgeInsets) {.top = 44})
+#define LAYOUT_ENTRY_SUB_INSETS ((GEdgeInsets) {.top = 150, .right = 8, .bottom = 12, .left = 8})
+#define LAYOUT_ALARM_ICON_INSETS ((GEdgeInsets) {.top = 10, .right = 38, .bottom = 100, .left = 8})
+#define LAYOUT_ALARM_LABEL_INSETS ((GEdgeInsets) {.top = 132, .right = ACTION_BAR_WIDTH, .left = ACTION_BAR_WIDTH / 2})
+
+// Timeline: the legs and the endurance share the x axis of LEGS
+#define LAYOUT_TIMELINE_TITLE GRect(0, 4, 200, 24)
+#define LAYOUT_TIMELINE_LEGS GRect(10, 34, 180, 80)
+#define LAYOUT_TIMELINE_FUEL GRect(10, 122, 180, 74)
+#define LAYOUT_TIMELINE_AXIS GRect(10, 200, 180, 20)
+
+#elif defined(PBL_ROUND)
+
+// 180x180, the rows kept inside the circle. The stopwatch uses the medium
+// digits so that the start minute still fits next to it at the bottom.
+#define LAYOUT_CLOCK GRect(25, 20, 130, 44)
+#define LAYOUT_CLOCK_DESC GRect(35, 48, 30, 26)
+#define LAYOUT_BATTERY GRect(30, 72, 120, 2)
+#define LAYOUT_INFO_LABEL GRect(18, 74, 144, 44)
+#define LAYOUT_INFO_VALUE GRect(85, 87, 76, 30)
+#define LAYOUT_INFO_LIVE GRect(90, 79, 72, 9)
+#define LAYOUT_ENDURANCE GRect(18, 121, 144, 10)
+#define LAYOUT_ET_FONT DIGIT_FONT_MEDIUM
+#define LAYOUT_ET_COUNTER GRect(38, 132, 112, 30)
+#define LAYOUT_ET_START GRect(38, 124, 112, 44)
+#define LAYOUT_ET_DESC GRect(78, 152, 24, 26)
+
+#define LAYOUT_ENTRY_MAIN_INSETS ((GEdgeInsets) {.top = 30})
+#define LAYOUT_ENTRY_SUB_INSETS ((GEdgeInsets) {.top = 115, .right = 20, .bottom = 10, .left = 20})
+#define LAYOUT_ALARM_ICON_INSETS ((GEdgeInsets) {.top = 12, .right = 38, .bottom = 76, .left = 24})
+#define LAYOUT_ALARM_LABEL_INSETS ((GEdgeInsets) {.top = 96, .right = ACTION_BAR_WIDTH + 4, .left = ACTION_BAR_WIDTH / 2 + 14})
+
+#define LAYOUT_TIMELINE_TITLE GRect(30, 12, 120, 22)
+#define LAYOUT_TIMELINE_LEGS GRect(30, 38, 120, 46)
+#define LAYOUT_TIMELINE_FUEL GRect(30, 90, 120, 44)
+#define LAYOUT_TIMELINE_AXIS GRect(30, 136, 120, 18)
+
+#else
+
+// 144x168: basalt and diorite
+#define LAYOUT_CLOCK GRect(0, 0, 144, 44)
+#define LAYOUT_CLOCK_DESC GRect(10, 28, 30, 26)
+#define LAYOUT_BATTERY GRect(0, 58, 144, 2)
+#define LAYOUT_INFO_LABEL GRect(0, 60, 144, 44)
+#define LAYOUT_INFO_VALUE GRect(67, 73, 76, 30)
+#define LAYOUT_INFO_LIVE GRect(72, 65, 72, 9)
+#define LAYOUT_ENDURANCE GRect(0, 107, 144, 10)
+#define LAYOUT_ET_FONT DIGIT_FONT_LARGE
+#define LAYOUT_ET_COUNTER GRect(0, 115, 144, 44)
+#define LAYOUT_ET_START GRect(0, 115, 144, 44)
+#define LAYOUT_ET_DESC GRect(10, 142, 20, 26)
+
+#define LAYOUT_ENTRY_MAIN_INSETS ((GEdgeInsets) {.top = 30})
+#define LAYOUT_ENTRY_SUB_INSETS ((GEdgeInsets) {.top = 115, .right = 5, .bottom = 10, .left = 5})
+#define LAYOUT_ALARM_ICON_INSETS ((GEdgeInsets) {.top = 1, .right = 28, .bottom = 66, .left = 14})
+#define LAYOUT_ALARM_LABEL_INSETS ((GEdgeInsets) {.top = 90, .right = ACTION_BAR_WIDTH, .left = ACTION_BAR_WIDTH / 2})
+
+#define LAYOUT_TIMELINE_TITLE GRect(0, 0, 144, 22)
+#define LAYOUT_TIMELINE_LEGS GRect(6, 26, 132, 56)
+#define LAYOUT_TIMELINE_FUEL GRect(6, 88, 132, 56)
+#define LAYOUT_TIMELINE_AXIS GRect(6, 146, 132, 18)
+
+#endif
@@ -4,36 +4,66 @@
 #include "components/clock.h"
 #include "components/endurance.h"
 #include "components/mission.h"
+#include "components/navlog.h"
 #include "windows/flight_menu.h"
+#include "windows/check_msg.h"
+#include "windows/checklist_window.h"
+#include "windows/timeline_window.h"
+#include "services/logbook.h"
+#include "services/comm.h"
+#include "services/telemetry.h"
+#include "services/flight_plan.h"
+#include "services/digit_font.h"
+#include "services/latency_trace.h"
+#include "services/profile.h"
+#include "services/battery_monitor.h"
+#include "services/power.h"
+#include "services/settings.h"
+#include "services/startup_trace.h"
 
 static Window *s_main_window;
+static Layer *s_first_frame_layer;
+static bool s_first_frame_drawn;
+
+static void tick_update(time_t tick) {
+  PROFILE_CALL(PROFILE_CLOCK, clock_update(tick));
+  PROFILE_CALL(PROFILE_MISSION, mission_update(tick));
+  PROFILE_CALL(PROFILE_ENDURANCE, endurance_update());
+  PROFILE_CALL(PROFILE_NAVLOG, navlog_update(tick));
+  timeline_window_update(tick);
+}
 
 static void tick_handler(struct tm *tick_time, TimeUnits units_changed) {
-  time_t tick = time(NULL);
-  clock_update(tick);
-  elapsed_time_update(tick);
-  mission_update(tick);
-  endurance_update();
+  PROFILE_CALL(PROFILE_TICK, tick_update(time(NULL)));
 }
 
 static void down_single_click_handler(ClickRecognizerRef recognizer, void *context) {
+  latency_trace_click(recognizer, false);
   elapsed_time_flyback();
 }
 
 static void select_single_click_handler(ClickRecognizerRef recognizer, void *context) {
+  latency_trace_click(recognizer, false);
   mission_switch_display(false);
 }
 
 static void select_long_click_handler(ClickRecognizerRef recognizer, void *context) {
+  latency_trace_click(recognizer, true);
   mission_switch_display(true);
 }
 
 static void up_single_click_handler(ClickRecognizerRef recognizer, void *context) {
-  mission_next();
+  latency_trace_click(recognizer, false);
+  if (!navlog_next()) {
+    mission_next();
+  }
 }
 
 static void up_long_click_handler(ClickRecognizerRef recognizer,  void *context) {
-  mission_previous();
+  latency_trace_click(recognizer, true);
+  if (!navlog_previous()) {
+    mission_previous();
+  }
 }
 
 static void back_single_click_handler(ClickRecognizerRef recognizer, void *context) {
@@ -47,20 +77,60 @@ static void config_provider(Window *window) {
   window_single_click_subscribe(BUTTON_ID_UP, up_single_click_handler);
   window_long_click_subscribe(BUTTON_ID_UP, 700, up_long_click_handler, NULL);
   window_single_click_subscribe(BUTTON_ID_BACK, back_single_click_handler);
+  latency_trace_subscribe();
+}
+
+// What the main display does not need waits for its first frame
+static void deferred_init(void *data) {
+  // Every other window, before any off-block: nothing is allocated in flight
+  check_msg_init();
+  checklist_window_init();
+  flight_menu_init();
+  // The main window is shown by now, the alarm goes on top of it
+  battery_check_forecast();
+  comm_init();
+  startup_trace_mark(STARTUP_INTERACTIVE);
+}
+
+// Drawn last, once the rest of the first frame has been rendered. Left in
+// place afterwards, removing it would redraw the window.
+static void first_frame_update_proc(Layer *layer, GContext *ctx) {
+  if (!s_first_frame_drawn) {
+    s_first_frame_drawn = true;
+    startup_trace_mark(STARTUP_FIRST_FRAME);
+    app_timer_register(0, deferred_init, NULL);
+  }
 }
 
+// The state is restored by now, so each layer is filled once
 static void main_window_load(Window *window) {
   Layer *window_layer = window_get_root_layer(window);
-  GRect bounds = layer_get_bounds(window_layer);
   
-  clock_init(window_layer, bounds);
-  battery_init(window_layer, bounds);
-  mission_init(window_layer, bounds);
-  endurance_init(window_layer, bounds);
-  et_init(window_layer, bounds);
+  clock_create(window_layer);
+  battery_create(window_layer);
+  mission_create(window_layer);
+  endurance_create(window_layer);
+  et_create(window_layer);
+  latency_trace_attach(window_layer);
+  
+  s_first_frame_layer = layer_create(layer_get_bounds(window_layer));
+  layer_set_update_proc(s_first_frame_layer, first_frame_update_proc);
+  layer_add_child(window_layer, s_first_frame_layer);
+}
+
+static void main_window_appear(Window *window) {
+  elapsed_time_set_visible(true);
+  battery_monitor_set_mode(BATTERY_MODE_TICKING, true);
+}
+
+static void main_window_disappear(Window *window) {
+  elapsed_time_set_visible(false);
+  battery_monitor_set_mode(BATTERY_MODE_TICKING, false);
 }
 
 static void main_window_unload(Window *window) {
+  layer_destroy(s_first_frame_layer);
+  latency_trace_detach();
   clock_destroy();
   et_destroy();
   battery_destroy();
@@ -68,28 +138,49 @@ static void main_window_unload(Window *window) {
   endurance_destroy();
 }
 
+// Only the main display is built before the first frame, the other windows
+// and the phone channel right after the frame
 static void init() {
+  startup_trace_begin();
+  settings_init();
+  logbook_init();
+  telemetry_init();
+  battery_monitor_init();
+  flight_plan_init();
+  
+  mission_init();
+  if (flight_plan_is_loaded()) {
+    endurance_set_takeoff_value(flight_plan_get_endurance());
+  }
+  elapsed_time_flyback();
+  battery_sample(battery_state_service_peek());
+  
   s_main_window = window_create();
   window_set_background_color(s_main_window, GColorBlack);
   
   window_set_window_handlers(s_main_window, (WindowHandlers) {
     .load = main_window_load,
+    .appear = main_window_appear,
+    .disappear = main_window_disappear,
     .unload = main_window_unload
   });
+  window_set_click_config_provider(s_main_window, (ClickConfigProvider) config_provider);
   window_stack_push(s_main_window, true);
   
-  tick_timer_service_subscribe(SECOND_UNIT, tick_handler);
+  power_init(tick_handler);
   battery_state_service_subscribe(battery_callback);
-  
-  window_set_click_config_provider(s_main_window, (ClickConfigProvider) config_provider);
-  
-  clock_update(time(NULL));
-  battery_callback(battery_state_service_peek());
-  elapsed_time_flyback();
+  startup_trace_mark(STARTUP_INIT);
 }
 
 static void deinit() {
+  power_deinit();
   window_destroy(s_main_window);
+  checklist_window_deinit();
+  check_msg_deinit();
+  flight_menu_deinit();
+  digit_font_deinit();
+  telemetry_deinit();
+  battery_monitor_deinit();
 }
 
 int main(void) {
@@ -0,0 +1,9 @@
+#pragma once
+
+// Persistent storage keys, kept in one place so modules don't collide.
+#define PERSIST_KEY_LOGBOOK_HEADER 100
+#define PERSIST_KEY_LOGBOOK_BASE 101 // LOGBOOK_CAPACITY + 1 consecutive keys
+#define PERSIST_KEY_FLIGHT_PLAN 140
+#define PERSIST_KEY_BATTERY_RATES 141
+#define PERSIST_KEY_SETTINGS 142
+#define PERSIST_KEY_FLIGHT_PLAN_USED 143
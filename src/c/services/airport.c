@@ -0,0 +1,16 @@
+#include <pebble.h>
+#include "airport.h"
+#include "data_table.h"
+
+static data_table_t s_table = DATA_TABLE(AIRPORTS);
+
+bool airport_find(const char *icao, airport_t *airport) {
+  char key[sizeof(airport->icao)] = {0};
+  strncpy(key, icao, sizeof(key));
+  
+  uint16_t offset, length;
+  if (!data_table_find(&s_table, key, &offset, &length) || length != sizeof(airport_t)) {
+    return false;
+  }
+  return data_table_read(&s_table, offset, airport, sizeof(airport_t)) == sizeof(airport_t);
+}
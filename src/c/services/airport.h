@@ -0,0 +1,7 @@
+#pragma once
+#include <pebble.h>
+#include "../generated/data_tables.h"
+
+typedef data_airports_record_t airport_t;
+
+bool airport_find(const char *icao, airport_t *airport);
@@ -0,0 +1,143 @@
+#include <pebble.h>
+#include "battery_monitor.h"
+#include "../persist_keys.h"
+
+// The firmware reports the charge in coarse steps, so the drain between two
+// samples is shared between the modes in proportion to the time spent in
+// each, weighted by their current rates. Each mode keeps running sums of
+// drain and time, the rate is their ratio: a new sample only adds to the
+// sums, nothing is refitted. The sums are halved once they cover more than
+// BATTERY_HISTORY so the rates follow an ageing battery.
+
+#define BATTERY_RING_SIZE 8
+#define BATTERY_HISTORY (24 * SECONDS_PER_HOUR)
+// Weight of the default rates, as if observed for that long
+#define BATTERY_PRIOR SECONDS_PER_HOUR
+// Share of the flight spent on alarms until one has been observed
+#define BATTERY_ALARM_SHARE_DEFAULT 5 // percent
+
+typedef struct Battery_rates {
+  uint32_t drain[BATTERY_MODE_COUNT]; // hundredths of a percent
+  uint32_t seconds[BATTERY_MODE_COUNT];
+} battery_rates_t;
+
+// Conservative guesses in hundredths of a percent per hour
+static const uint16_t s_default_rates[BATTERY_MODE_COUNT] = { 100, 150, 1500 };
+
+static battery_sample_t s_ring[BATTERY_RING_SIZE];
+static uint8_t s_head = 0;
+static uint8_t s_count = 0;
+
+static battery_rates_t s_rates;
+// Time spent in each mode since the last sample
+static uint32_t s_interval[BATTERY_MODE_COUNT];
+static time_t s_mode_since;
+static uint8_t s_modes = 1 << BATTERY_MODE_FOREGROUND;
+
+static battery_mode_t current_mode() {
+  for (int mode = BATTERY_MODE_COUNT - 1; mode > 0; mode--) {
+    if (s_modes & (1 << mode)) {
+      return mode;
+    }
+  }
+  return BATTERY_MODE_FOREGROUND;
+}
+
+static void account(time_t now) {
+  s_interval[current_mode()] += now - s_mode_since;
+  s_mode_since = now;
+}
+
+static const battery_sample_t *last_sample() {
+  return s_count > 0 ? &s_ring[(s_head + BATTERY_RING_SIZE - 1) % BATTERY_RING_SIZE] : NULL;
+}
+
+static void push(battery_sample_t sample) {
+  s_ring[s_head] = sample;
+  s_head = (s_head + 1) % BATTERY_RING_SIZE;
+  if (s_count < BATTERY_RING_SIZE) {
+    s_count++;
+  }
+}
+
+// Shares a drop of the charge between the modes of the interval
+static void learn(uint32_t drop) {
+  uint64_t weights[BATTERY_MODE_COUNT];
+  uint64_t total = 0;
+  for (int mode = 0; mode < BATTERY_MODE_COUNT; mode++) {
+    weights[mode] = (uint64_t)s_interval[mode] * battery_monitor_get_rate(mode);
+    total += weights[mode];
+  }
+  if (total == 0) {
+    return;
+  }
+  
+  for (int mode = 0; mode < BATTERY_MODE_COUNT; mode++) {
+    s_rates.drain[mode] += drop * weights[mode] / total;
+    s_rates.seconds[mode] += s_interval[mode];
+    if (s_rates.seconds[mode] > BATTERY_HISTORY) {
+      s_rates.drain[mode] /= 2;
+      s_rates.seconds[mode] /= 2;
+    }
+  }
+}
+
+void battery_monitor_init() {
+  if (persist_exists(PERSIST_KEY_BATTERY_RATES)) {
+    persist_read_data(PERSIST_KEY_BATTERY_RATES, &s_rates, sizeof(s_rates));
+  }
+  s_mode_since = time(NULL);
+}
+
+void battery_monitor_deinit() {
+  persist_write_data(PERSIST_KEY_BATTERY_RATES, &s_rates, sizeof(s_rates));
+}
+
+void battery_monitor_sample(BatteryChargeState state) {
+  time_t now = time(NULL);
+  account(now);
+  
+  const battery_sample_t *last = last_sample();
+  bool charging = state.is_charging || state.is_plugged;
+  if (last != NULL && !last->charging && !charging && state.charge_percent < last->percent) {
+    learn((last->percent - state.charge_percent) * 100);
+  }
+  // A new interval starts, also after a charge where nothing is learnt
+  memset(s_interval, 0, sizeof(s_interval));
+  
+  push((battery_sample_t) {
+    .timestamp = now,
+    .percent = state.charge_percent,
+    .mode = current_mode(),
+    .charging = charging
+  });
+}
+
+void battery_monitor_set_mode(battery_mode_t mode, bool active) {
+  account(time(NULL));
+  if (active) {
+    s_modes |= 1 << mode;
+  } else {
+    s_modes &= ~(1 << mode);
+  }
+}
+
+uint16_t battery_monitor_get_rate(battery_mode_t mode) {
+  uint32_t drain = s_rates.drain[mode] + (uint32_t)s_default_rates[mode] * BATTERY_PRIOR / SECONDS_PER_HOUR;
+  return drain * SECONDS_PER_HOUR / (s_rates.seconds[mode] + BATTERY_PRIOR);
+}
+
+time_t battery_monitor_get_remaining() {
+  const battery_sample_t *last = last_sample();
+  if (last == NULL) {
+    return 0;
+  }
+  
+  uint32_t ticking = s_rates.seconds[BATTERY_MODE_TICKING];
+  uint32_t alarm = s_rates.seconds[BATTERY_MODE_ALARM];
+  uint32_t alarm_share = alarm > 0 ? alarm * 100 / (ticking + alarm) : BATTERY_ALARM_SHARE_DEFAULT;
+  uint32_t rate = (battery_monitor_get_rate(BATTERY_MODE_TICKING) * (100 - alarm_share)
+                   + battery_monitor_get_rate(BATTERY_MODE_ALARM) * alarm_share) / 100;
+  
+  return (uint32_t)last->percent * 100 * SECONDS_PER_HOUR / rate;
+}
@@ -0,0 +1,31 @@
+#pragma once
+#include <pebble.h>
+
+// Drain rate of the watch battery, learnt from the charge level changes and
+// the time spent in each mode in between. When several modes are active the
+// highest one counts.
+typedef enum Battery_mode {
+  BATTERY_MODE_FOREGROUND, // app open, stopwatch hidden behind a menu
+  BATTERY_MODE_TICKING, // main screen updating every second
+  BATTERY_MODE_ALARM, // alarm shown, vibrations and backlight
+  BATTERY_MODE_COUNT
+} battery_mode_t;
+
+typedef struct __attribute__((__packed__)) Battery_sample {
+  uint32_t timestamp;
+  uint8_t percent;
+  uint8_t mode;
+  bool charging;
+} battery_sample_t;
+
+// Restores the rates learnt by previous runs
+void battery_monitor_init();
+// Saves the rates
+void battery_monitor_deinit();
+void battery_monitor_sample(BatteryChargeState state);
+void battery_monitor_set_mode(battery_mode_t mode, bool active);
+
+// Hundredths of a percent per hour
+uint16_t battery_monitor_get_rate(battery_mode_t mode);
+// Seconds until empty when flying: ticking, with alarms now and then
+time_t battery_monitor_get_remaining();
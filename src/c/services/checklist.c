@@ -0,0 +1,101 @@
+#include <pebble.h>
+#include "checklist.h"
+#include "data_table.h"
+
+// Checklists are read straight from the CHECKLISTS data table, one record
+// per list (see pack_lists in tools/pack_resources.py for the layout).
+// Only a page of consecutive items around the one requested is kept in
+// RAM, the menu showing them draws a handful of rows at a time.
+
+#define CHECKLIST_PAGE_ITEMS 8
+#define CHECKLIST_PAGE_BYTES 320
+#define CHECKLIST_TITLE_SIZE 24
+#define LIST_HEADER_SIZE 4
+
+typedef struct List_entry {
+  uint16_t record; // offset of the list record in the resource
+  uint16_t title;
+  uint16_t item_count;
+} list_entry_t;
+
+typedef struct Page {
+  uint16_t first; // item index in the list, count == 0 when empty
+  uint8_t count;
+  uint16_t offsets[CHECKLIST_PAGE_ITEMS + 1];
+  char text[CHECKLIST_PAGE_BYTES];
+} page_t;
+
+static data_table_t s_table = DATA_TABLE(CHECKLISTS);
+static checklist_id_t s_cached_list = CHECKLIST_NONE;
+static list_entry_t s_cached_entry;
+static page_t s_page;
+
+static bool read_list(checklist_id_t list, list_entry_t *entry) {
+  if (list != s_cached_list) {
+    uint16_t record, length;
+    if (!data_table_entry(&s_table, list, &record, &length)) {
+      return false;
+    }
+    uint8_t raw[LIST_HEADER_SIZE];
+    data_table_read(&s_table, record, raw, sizeof(raw));
+    s_cached_entry.record = record;
+    s_cached_entry.title = raw[0] | raw[1] << 8;
+    s_cached_entry.item_count = raw[2] | raw[3] << 8;
+    s_cached_list = list;
+    s_page.count = 0;
+  }
+  *entry = s_cached_entry;
+  return true;
+}
+
+static void load_page(const list_entry_t *entry, uint16_t first) {
+  uint16_t available = entry->item_count - first;
+  uint8_t count = available < CHECKLIST_PAGE_ITEMS ? available : CHECKLIST_PAGE_ITEMS;
+  
+  uint8_t raw[(CHECKLIST_PAGE_ITEMS + 1) * 2];
+  data_table_read(&s_table, entry->record + LIST_HEADER_SIZE + first * 2, raw, (count + 1) * 2);
+  for (int i = 0; i <= count; i++) {
+    s_page.offsets[i] = raw[i * 2] | raw[i * 2 + 1] << 8;
+  }
+  // drop trailing items until the strings fit the page buffer
+  while (count > 1 && s_page.offsets[count] - s_page.offsets[0] > CHECKLIST_PAGE_BYTES) {
+    count--;
+  }
+  
+  data_table_read(&s_table, entry->record + s_page.offsets[0], s_page.text, s_page.offsets[count] - s_page.offsets[0]);
+  s_page.first = first;
+  s_page.count = count;
+}
+
+uint16_t checklist_get_list_count() {
+  return data_table_open(&s_table) ? s_table.count : 0;
+}
+
+const char *checklist_get_title(checklist_id_t list) {
+  static char s_title[CHECKLIST_TITLE_SIZE];
+  list_entry_t entry;
+  if (!read_list(list, &entry)) {
+    return "";
+  }
+  data_table_read(&s_table, entry.record + entry.title, s_title, sizeof(s_title));
+  s_title[sizeof(s_title) - 1] = '\0';
+  return s_title;
+}
+
+uint16_t checklist_get_item_count(checklist_id_t list) {
+  list_entry_t entry;
+  return read_list(list, &entry) ? entry.item_count : 0;
+}
+
+const char *checklist_get_item(checklist_id_t list, uint16_t index) {
+  list_entry_t entry;
+  if (!read_list(list, &entry) || index >= entry.item_count) {
+    return "";
+  }
+  
+  if (s_page.count == 0 || index < s_page.first || index >= s_page.first + s_page.count) {
+    // start the page a little before the item so scrolling up also hits it
+    load_page(&entry, index >= 2 ? index - 2 : 0);
+  }
+  return s_page.text + s_page.offsets[index - s_page.first] - s_page.offsets[0];
+}
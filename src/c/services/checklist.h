@@ -0,0 +1,13 @@
+#pragma once
+#include <pebble.h>
+#include "../generated/data_tables.h"
+#define CHECKLIST_MAX_ITEMS DATA_CHECKLISTS_MAX_ITEMS
+#define CHECKLIST_NONE DATA_CHECKLISTS_COUNT
+
+// Ids are generated from resources/data/checklists.yaml
+typedef uint8_t checklist_id_t;
+
+uint16_t checklist_get_list_count();
+const char *checklist_get_title(checklist_id_t list);
+uint16_t checklist_get_item_count(checklist_id_t list);
+const char *checklist_get_item(checklist_id_t list, uint16_t index);
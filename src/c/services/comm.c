@@ -0,0 +1,60 @@
+#include <pebble.h>
+#include "comm.h"
+#include "export.h"
+#include "flight_plan.h"
+#include "settings.h"
+#include "logbook.h"
+
+// Single owner of the AppMessage channel, messages are routed to the
+// services by the keys they carry.
+
+static uint32_t s_outbox_size;
+
+static void inbox_received_handler(DictionaryIterator *iter, void *context) {
+  if (dict_find(iter, MESSAGE_KEY_FlightPlan) != NULL) {
+    flight_plan_handle_message(iter);
+  } else if (dict_find(iter, MESSAGE_KEY_Settings) != NULL) {
+    settings_handle_message(iter);
+  } else if (dict_find(iter, MESSAGE_KEY_Patch) != NULL) {
+    logbook_handle_patch(iter);
+  } else if (dict_find(iter, MESSAGE_KEY_Ack) != NULL) {
+    export_handle_ack(iter);
+  } else if (dict_find(iter, MESSAGE_KEY_Command) != NULL) {
+    export_handle_command(iter);
+  }
+}
+
+static void inbox_dropped_handler(AppMessageResult reason, void *context) {
+  APP_LOG(APP_LOG_LEVEL_WARNING, "Inbox dropped: %d", (int)reason);
+}
+
+static void outbox_sent_handler(DictionaryIterator *iter, void *context) {
+  logbook_outbox_sent(iter);
+  if (dict_find(iter, MESSAGE_KEY_Seq) != NULL) {
+    export_outbox_sent(iter);
+  }
+}
+
+static void outbox_failed_handler(DictionaryIterator *iter, AppMessageResult reason, void *context) {
+  APP_LOG(APP_LOG_LEVEL_WARNING, "Outbox failed: %d", (int)reason);
+  logbook_outbox_failed(iter);
+  if (dict_find(iter, MESSAGE_KEY_Seq) != NULL) {
+    export_outbox_failed(iter);
+  }
+}
+
+void comm_init() {
+  app_message_register_inbox_received(inbox_received_handler);
+  app_message_register_inbox_dropped(inbox_dropped_handler);
+  app_message_register_outbox_sent(outbox_sent_handler);
+  app_message_register_outbox_failed(outbox_failed_handler);
+  
+  uint32_t inbox_max = app_message_inbox_size_maximum();
+  uint32_t outbox_max = app_message_outbox_size_maximum();
+  s_outbox_size = outbox_max < COMM_OUTBOX_SIZE ? outbox_max : COMM_OUTBOX_SIZE;
+  app_message_open(inbox_max < COMM_INBOX_SIZE ? inbox_max : COMM_INBOX_SIZE, s_outbox_size);
+}
+
+uint32_t comm_get_outbox_size() {
+  return s_outbox_size;
+}
@@ -0,0 +1,7 @@
+#pragma once
+#include <pebble.h>
+#define COMM_INBOX_SIZE 256
+#define COMM_OUTBOX_SIZE 256
+
+void comm_init();
+uint32_t comm_get_outbox_size();
@@ -0,0 +1,83 @@
+#include <pebble.h>
+#include "data_table.h"
+
+#define DATA_TABLE_MAX_KEY_SIZE 8
+
+typedef struct __attribute__((__packed__)) Table_header {
+  char magic[4];
+  uint8_t version;
+  uint8_t key_size;
+  uint16_t count;
+  uint16_t record_size;
+  uint16_t index_offset;
+  uint32_t checksum;
+} table_header_t;
+
+// Only the header is checked, against the values the app was compiled
+// with: a stale resource is refused without reading the whole table.
+bool data_table_open(data_table_t *table) {
+  if (table->handle != 0) {
+    return table->valid;
+  }
+  
+  table->handle = resource_get_handle(table->resource_id);
+  table_header_t header;
+  table->valid = resource_load_byte_range(table->handle, 0, (uint8_t *)&header, sizeof(header)) == sizeof(header)
+    && memcmp(header.magic, DATA_TABLE_MAGIC, sizeof(header.magic)) == 0
+    && header.version == DATA_TABLE_VERSION
+    && header.checksum == table->checksum
+    && header.count == table->count
+    && header.key_size == table->key_size
+    && table->key_size <= DATA_TABLE_MAX_KEY_SIZE;
+  
+  if (!table->valid) {
+    APP_LOG(APP_LOG_LEVEL_ERROR, "Data table %d does not match the build", (int)table->resource_id);
+  }
+  return table->valid;
+}
+
+static void read_entry(data_table_t *table, uint16_t position, uint8_t *key, uint16_t *offset, uint16_t *length) {
+  uint8_t raw[DATA_TABLE_MAX_KEY_SIZE + 4];
+  uint8_t entry_size = table->key_size + 4;
+  resource_load_byte_range(table->handle, DATA_TABLE_HEADER_SIZE + position * entry_size, raw, entry_size);
+  if (key != NULL) {
+    memcpy(key, raw, table->key_size);
+  }
+  *offset = raw[table->key_size] | raw[table->key_size + 1] << 8;
+  *length = raw[table->key_size + 2] | raw[table->key_size + 3] << 8;
+}
+
+bool data_table_entry(data_table_t *table, uint16_t position, uint16_t *offset, uint16_t *length) {
+  if (!data_table_open(table) || position >= table->count) {
+    return false;
+  }
+  read_entry(table, position, NULL, offset, length);
+  return true;
+}
+
+// Binary search of the sorted index, one small flash read per step
+bool data_table_find(data_table_t *table, const void *key, uint16_t *offset, uint16_t *length) {
+  if (!data_table_open(table)) {
+    return false;
+  }
+  
+  uint8_t candidate[DATA_TABLE_MAX_KEY_SIZE];
+  int low = 0, high = table->count - 1;
+  while (low <= high) {
+    int middle = (low + high) / 2;
+    read_entry(table, middle, candidate, offset, length);
+    int order = memcmp(candidate, key, table->key_size);
+    if (order == 0) {
+      return true;
+    } else if (order < 0) {
+      low = middle + 1;
+    } else {
+      high = middle - 1;
+    }
+  }
+  return false;
+}
+
+size_t data_table_read(data_table_t *table, uint32_t offset, void *buffer, size_t length) {
+  return resource_load_byte_range(table->handle, offset, buffer, length);
+}
@@ -0,0 +1,25 @@
+#pragma once
+#include <pebble.h>
+#include "../generated/data_tables.h"
+
+// A table packed by tools/pack_resources.py, read in place from flash
+typedef struct Data_table {
+  uint32_t resource_id;
+  uint32_t checksum;
+  uint16_t count;
+  uint8_t key_size;
+  ResHandle handle;
+  bool valid;
+} data_table_t;
+
+#define DATA_TABLE(NAME) { \
+  .resource_id = DATA_##NAME##_RESOURCE, \
+  .checksum = DATA_##NAME##_CHECKSUM, \
+  .count = DATA_##NAME##_COUNT, \
+  .key_size = DATA_##NAME##_KEY_SIZE \
+}
+
+bool data_table_open(data_table_t *table);
+bool data_table_entry(data_table_t *table, uint16_t position, uint16_t *offset, uint16_t *length);
+bool data_table_find(data_table_t *table, const void *key, uint16_t *offset, uint16_t *length);
+size_t data_table_read(data_table_t *table, uint32_t offset, void *buffer, size_t length);
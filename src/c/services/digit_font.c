@@ -0,0 +1,27 @@
+#include <pebble.h>
+#include "digit_font.h"
+
+static const uint32_t s_resources[DIGIT_FONT_COUNT] = {
+  [DIGIT_FONT_LARGE] = RESOURCE_ID_DIGITS_34,
+  [DIGIT_FONT_MEDIUM] = RESOURCE_ID_DIGITS_24
+};
+
+static GFont s_fonts[DIGIT_FONT_COUNT];
+
+GFont digit_font_get(digit_font_t font) {
+  if (s_fonts[font] == NULL) {
+    size_t heap_before = heap_bytes_used();
+    s_fonts[font] = fonts_load_custom_font(resource_get_handle(s_resources[font]));
+    APP_LOG(APP_LOG_LEVEL_DEBUG, "Digit font %d: %d bytes of heap", font, (int)(heap_bytes_used() - heap_before));
+  }
+  return s_fonts[font];
+}
+
+void digit_font_deinit() {
+  for (int i = 0; i < DIGIT_FONT_COUNT; i++) {
+    if (s_fonts[i] != NULL) {
+      fonts_unload_custom_font(s_fonts[i]);
+      s_fonts[i] = NULL;
+    }
+  }
+}
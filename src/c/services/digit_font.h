@@ -0,0 +1,12 @@
+#pragma once
+#include <pebble.h>
+
+// Custom fonts for the large numeric fields. The resources only hold digits,
+// ':', '.' and '-' (see characterRegex in package.json).
+typedef enum DigitFont {
+  DIGIT_FONT_LARGE, DIGIT_FONT_MEDIUM, DIGIT_FONT_COUNT
+} digit_font_t;
+
+// Loaded on first use and shared by every caller until digit_font_deinit
+GFont digit_font_get(digit_font_t font);
+void digit_font_deinit();
@@ -0,0 +1,232 @@
+#include <pebble.h>
+#include "export.h"
+#include "comm.h"
+#include "logbook.h"
+
+// Logbook sync to the phone. Only the flights changed after a sequence
+// number are sent: the watch asks from the last one the phone confirmed,
+// the phone from the last one it holds, 0 for the whole logbook. They are
+// packed into as few chunks as the outbox allows and up to EXPORT_WINDOW
+// chunks are sent ahead of the phone's cumulative acknowledgement. The
+// outbox only holds one message at a time, so the window is kept at the
+// application level: the next chunk leaves as soon as the previous one is
+// handed to the phone, and a missing acknowledgement rewinds to the oldest
+// unacknowledged chunk.
+
+#define EXPORT_WINDOW 4
+#define EXPORT_ACK_TIMEOUT_MS 3000
+#define EXPORT_RETRY_DELAY_MS 250
+#define EXPORT_MAX_RETRIES 5
+#define EXPORT_COMMAND_START 1
+
+typedef struct Export {
+  bool running;
+  bool sending;
+  uint16_t records_per_chunk;
+  uint16_t record_count;
+  uint16_t chunk_count;
+  uint16_t since;
+  uint16_t sequence; // of the logbook when the sync started, confirmed at the end
+  uint16_t base; // oldest chunk not yet acknowledged
+  uint16_t next; // next chunk to hand to the outbox
+  uint8_t retries;
+  time_t start_s;
+  uint16_t start_ms;
+  AppTimer *ack_timer;
+  AppTimer *retry_timer;
+} export_t;
+
+static export_t s_export;
+static uint8_t s_chunk[COMM_OUTBOX_SIZE];
+static uint16_t s_selection[LOGBOOK_CAPACITY]; // numbers of the flights to send
+
+static void pump();
+
+static void cancel_timers() {
+  if (s_export.ack_timer != NULL) {
+    app_timer_cancel(s_export.ack_timer);
+    s_export.ack_timer = NULL;
+  }
+  if (s_export.retry_timer != NULL) {
+    app_timer_cancel(s_export.retry_timer);
+    s_export.retry_timer = NULL;
+  }
+}
+
+static void finish(bool success) {
+  cancel_timers();
+  s_export.running = false;
+  
+  time_t end_s;
+  uint16_t end_ms;
+  time_ms(&end_s, &end_ms);
+  int elapsed_ms = (end_s - s_export.start_s) * 1000 + end_ms - s_export.start_ms;
+  int records = s_export.record_count;
+  APP_LOG(APP_LOG_LEVEL_INFO, "Sync %s: %d of %d records since %d, %d chunks in %d ms (%d records/s)",
+          success ? "done" : "aborted", records, logbook_count(), s_export.since, s_export.chunk_count, elapsed_ms,
+          elapsed_ms > 0 ? records * 1000 / elapsed_ms : records);
+  if (success) {
+    logbook_set_synced(s_export.sequence);
+  }
+}
+
+static bool send_chunk(uint16_t seq) {
+  DictionaryIterator *iter;
+  if (app_message_outbox_begin(&iter) != APP_MSG_OK) {
+    return false;
+  }
+  
+  // A flight overwritten since the start is skipped, the phone counts
+  // the records it gets against the total
+  uint16_t count = 0;
+  for (uint16_t i = seq * s_export.records_per_chunk;
+       i < s_export.record_count && i < (seq + 1) * s_export.records_per_chunk; i++) {
+    if (logbook_find(s_selection[i], (flight_t *)(s_chunk + count * sizeof(flight_t)))) {
+      count++;
+    }
+  }
+  
+  dict_write_uint16(iter, MESSAGE_KEY_Seq, seq);
+  dict_write_uint16(iter, MESSAGE_KEY_Total, s_export.record_count);
+  dict_write_uint8(iter, MESSAGE_KEY_RecordSize, sizeof(flight_t));
+  dict_write_data(iter, MESSAGE_KEY_Chunk, s_chunk, count * sizeof(flight_t));
+  return app_message_outbox_send() == APP_MSG_OK;
+}
+
+static void retry_callback(void *data) {
+  s_export.retry_timer = NULL;
+  pump();
+}
+
+static void schedule_retry() {
+  if (s_export.retry_timer == NULL) {
+    s_export.retry_timer = app_timer_register(EXPORT_RETRY_DELAY_MS, retry_callback, NULL);
+  }
+}
+
+static void ack_timeout(void *data) {
+  s_export.ack_timer = NULL;
+  if (++s_export.retries > EXPORT_MAX_RETRIES) {
+    finish(false);
+    return;
+  }
+  s_export.next = s_export.base;
+  pump();
+}
+
+static void arm_ack_timer() {
+  if (s_export.ack_timer == NULL) {
+    s_export.ack_timer = app_timer_register(EXPORT_ACK_TIMEOUT_MS, ack_timeout, NULL);
+  } else {
+    app_timer_reschedule(s_export.ack_timer, EXPORT_ACK_TIMEOUT_MS);
+  }
+}
+
+static void pump() {
+  if (!s_export.running || s_export.sending) {
+    return;
+  }
+  if (s_export.base >= s_export.chunk_count) {
+    finish(true);
+    return;
+  }
+  if (s_export.next >= s_export.chunk_count || s_export.next >= s_export.base + EXPORT_WINDOW) {
+    return;
+  }
+  
+  // The timeout runs for the oldest unacknowledged chunk: armed when it
+  // leaves, rearmed when an acknowledgement moves the base
+  bool window_empty = s_export.next == s_export.base;
+  if (send_chunk(s_export.next)) {
+    s_export.sending = true;
+    s_export.next++;
+    if (window_empty) {
+      arm_ack_timer();
+    }
+  } else {
+    schedule_retry();
+  }
+}
+
+static uint16_t select_since(uint16_t since) {
+  uint16_t count = 0;
+  flight_t flight;
+  for (uint16_t i = 0; i < logbook_count(); i++) {
+    if (logbook_read(i, &flight) && flight.sequence > since) {
+      s_selection[count++] = flight.number;
+    }
+  }
+  return count;
+}
+
+void export_start(uint16_t since) {
+  if (s_export.running) {
+    return;
+  }
+  
+  uint32_t overhead = dict_calc_buffer_size(4, sizeof(uint16_t), sizeof(uint16_t), sizeof(uint8_t), 0);
+  uint16_t records_per_chunk = (comm_get_outbox_size() - overhead) / sizeof(flight_t);
+  uint16_t records = select_since(since);
+  
+  s_export = (export_t) {
+    .running = true,
+    .records_per_chunk = records_per_chunk,
+    .record_count = records,
+    // nothing to send still sends one empty chunk so the phone completes
+    .chunk_count = records == 0 ? 1 : (records + records_per_chunk - 1) / records_per_chunk,
+    .since = since,
+    .sequence = logbook_sequence(),
+  };
+  time_ms(&s_export.start_s, &s_export.start_ms);
+  pump();
+}
+
+bool export_is_running() {
+  return s_export.running;
+}
+
+void export_handle_command(DictionaryIterator *iter) {
+  Tuple *command = dict_find(iter, MESSAGE_KEY_Command);
+  Tuple *since = dict_find(iter, MESSAGE_KEY_Since);
+  if (command->value->int32 == EXPORT_COMMAND_START) {
+    export_start(since != NULL ? since->value->int32 : 0);
+  }
+}
+
+void export_handle_ack(DictionaryIterator *iter) {
+  if (!s_export.running) {
+    return;
+  }
+  
+  // The phone acknowledges the number of chunks it holds without gaps
+  uint16_t acked = dict_find(iter, MESSAGE_KEY_Ack)->value->int32;
+  if (acked > s_export.base && acked <= s_export.next) {
+    s_export.base = acked;
+    s_export.retries = 0;
+    if (s_export.base < s_export.next) {
+      arm_ack_timer();
+    } else if (s_export.ack_timer != NULL) {
+      app_timer_cancel(s_export.ack_timer);
+      s_export.ack_timer = NULL;
+    }
+  }
+  pump();
+}
+
+void export_outbox_sent(DictionaryIterator *iter) {
+  s_export.sending = false;
+  pump();
+}
+
+void export_outbox_failed(DictionaryIterator *iter) {
+  s_export.sending = false;
+  if (!s_export.running) {
+    return;
+  }
+  
+  Tuple *seq = dict_find(iter, MESSAGE_KEY_Seq);
+  if (seq != NULL && seq->value->uint16 < s_export.next) {
+    s_export.next = seq->value->uint16;
+  }
+  schedule_retry();
+}
@@ -0,0 +1,11 @@
+#pragma once
+#include <pebble.h>
+
+// Sends the flights changed after the sequence number since, 0 for all
+void export_start(uint16_t since);
+bool export_is_running();
+
+void export_handle_command(DictionaryIterator *iter);
+void export_handle_ack(DictionaryIterator *iter);
+void export_outbox_sent(DictionaryIterator *iter);
+void export_outbox_failed(DictionaryIterator *iter);
@@ -0,0 +1,169 @@
+#include <pebble.h>
+#include "flight_plan.h"
+#include "../utils.h"
+#include "../persist_keys.h"
+#include "../components/endurance.h"
+#include "../components/navlog.h"
+
+// Flight plans arrive from the phone as one byte array, little-endian:
+//   uint8 version, uint8 leg count, char departure[4], char alternate[4],
+//   uint16 fuel on board, uint16 reserve burn, uint16 alternate time (s),
+//   leg count * { char waypoint[4], uint16 planned time (s), uint16 burn },
+//   uint16 Fletcher-16 checksum of everything before it.
+// The validated blob is persisted as is and decoded again at start-up.
+
+#define PLAN_VERSION 1
+#define PLAN_HEADER_SIZE 16
+#define PLAN_LEG_SIZE 8
+#define PLAN_CHECKSUM_SIZE 2
+#define PLAN_IDENT_LENGTH 4
+
+static flight_plan_t s_plan;
+static bool s_loaded = false;
+static bool s_used = false;
+
+static bool read_ident(const uint8_t *data, char *ident) {
+  for (int i = 0; i < PLAN_IDENT_LENGTH; i++) {
+    char c = data[i];
+    if (!((c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == ' ' || c == '\0')) {
+      return false;
+    }
+    ident[i] = c == ' ' ? '\0' : c;
+  }
+  ident[PLAN_IDENT_LENGTH] = '\0';
+  return true;
+}
+
+static plan_status_t decode(const uint8_t *data, uint16_t length, flight_plan_t *plan) {
+  if (length < PLAN_HEADER_SIZE + PLAN_CHECKSUM_SIZE) {
+    return PLAN_BAD_LENGTH;
+  }
+  if (data[0] != PLAN_VERSION) {
+    return PLAN_BAD_VERSION;
+  }
+  
+  uint8_t leg_count = data[1];
+  if (leg_count == 0 || leg_count > FLIGHT_PLAN_MAX_LEGS) {
+    return PLAN_BAD_CONTENT;
+  }
+  if (length != PLAN_HEADER_SIZE + leg_count * PLAN_LEG_SIZE + PLAN_CHECKSUM_SIZE) {
+    return PLAN_BAD_LENGTH;
+  }
+  if (fletcher16(data, length - PLAN_CHECKSUM_SIZE) != read_uint16(data + length - PLAN_CHECKSUM_SIZE)) {
+    return PLAN_BAD_CHECKSUM;
+  }
+  
+  if (!read_ident(data + 2, plan->departure) || !read_ident(data + 6, plan->alternate)) {
+    return PLAN_BAD_CONTENT;
+  }
+  plan->fuel = read_uint16(data + 10);
+  plan->reserve_burn = read_uint16(data + 12);
+  plan->alternate_time = read_uint16(data + 14);
+  plan->leg_count = leg_count;
+  if (plan->reserve_burn == 0) {
+    return PLAN_BAD_CONTENT;
+  }
+  
+  const uint8_t *leg_data = data + PLAN_HEADER_SIZE;
+  for (int i = 0; i < leg_count; i++, leg_data += PLAN_LEG_SIZE) {
+    leg_t *leg = &plan->legs[i];
+    if (!read_ident(leg_data, leg->waypoint)) {
+      return PLAN_BAD_CONTENT;
+    }
+    leg->planned = read_uint16(leg_data + 4);
+    leg->burn = read_uint16(leg_data + 6);
+    if (leg->planned == 0 || leg->burn == 0) {
+      return PLAN_BAD_CONTENT;
+    }
+  }
+  return PLAN_OK;
+}
+
+void flight_plan_init() {
+  static uint8_t s_blob[PERSIST_DATA_MAX_LENGTH];
+  
+  if (persist_exists(PERSIST_KEY_FLIGHT_PLAN)) {
+    int length = persist_read_data(PERSIST_KEY_FLIGHT_PLAN, s_blob, sizeof(s_blob));
+    s_loaded = length > 0 && decode(s_blob, length, &s_plan) == PLAN_OK;
+  }
+  s_used = persist_exists(PERSIST_KEY_FLIGHT_PLAN_USED) && persist_read_bool(PERSIST_KEY_FLIGHT_PLAN_USED);
+}
+
+bool flight_plan_is_loaded() {
+  return s_loaded && !s_used;
+}
+
+void flight_plan_set_used(bool used) {
+  if (used != s_used) {
+    s_used = used;
+    persist_write_bool(PERSIST_KEY_FLIGHT_PLAN_USED, used);
+  }
+}
+
+const flight_plan_t *flight_plan_get() {
+  return flight_plan_is_loaded() ? &s_plan : NULL;
+}
+
+// Time until the tanks are dry when flying the route as planned and then
+// holding at the reserve burn rate.
+time_t flight_plan_get_endurance() {
+  if (!flight_plan_is_loaded()) {
+    return 0;
+  }
+  
+  // fuel times seconds, burn rates are per hour
+  uint32_t fuel = (uint32_t)s_plan.fuel * SECONDS_PER_HOUR;
+  time_t endurance = 0;
+  for (int i = 0; i < s_plan.leg_count; i++) {
+    const leg_t *leg = &s_plan.legs[i];
+    uint32_t leg_fuel = (uint32_t)leg->burn * leg->planned;
+    if (leg_fuel >= fuel) {
+      return endurance + fuel / leg->burn;
+    }
+    fuel -= leg_fuel;
+    endurance += leg->planned;
+  }
+  return endurance + fuel / s_plan.reserve_burn;
+}
+
+// Planned time en route, the sum of the legs
+time_t flight_plan_get_duration() {
+  if (!flight_plan_is_loaded()) {
+    return 0;
+  }
+  
+  time_t duration = 0;
+  for (int i = 0; i < s_plan.leg_count; i++) {
+    duration += s_plan.legs[i].planned;
+  }
+  return duration;
+}
+
+plan_status_t flight_plan_import(const uint8_t *data, uint16_t length) {
+  static flight_plan_t s_candidate;
+  
+  plan_status_t status = length <= PERSIST_DATA_MAX_LENGTH ? decode(data, length, &s_candidate) : PLAN_BAD_LENGTH;
+  if (status != PLAN_OK) {
+    APP_LOG(APP_LOG_LEVEL_WARNING, "Flight plan rejected: %d", (int)status);
+    return status;
+  }
+  
+  persist_write_data(PERSIST_KEY_FLIGHT_PLAN, data, length);
+  s_plan = s_candidate;
+  s_loaded = true;
+  flight_plan_set_used(false);
+  endurance_set_takeoff_value(flight_plan_get_endurance());
+  navlog_plan_changed();
+  return PLAN_OK;
+}
+
+void flight_plan_handle_message(DictionaryIterator *iter) {
+  Tuple *tuple = dict_find(iter, MESSAGE_KEY_FlightPlan);
+  plan_status_t status = tuple->type == TUPLE_BYTE_ARRAY ? flight_plan_import(tuple->value->data, tuple->length) : PLAN_BAD_CONTENT;
+  
+  DictionaryIterator *reply;
+  if (app_message_outbox_begin(&reply) == APP_MSG_OK) {
+    dict_write_uint8(reply, MESSAGE_KEY_FlightPlan, status);
+    app_message_outbox_send();
+  }
+}
@@ -0,0 +1,36 @@
+#pragma once
+#include <pebble.h>
+#define FLIGHT_PLAN_MAX_LEGS 16
+#define FLIGHT_PLAN_IDENT_SIZE 5
+
+typedef enum Plan_status {
+  PLAN_OK, PLAN_BAD_LENGTH, PLAN_BAD_VERSION, PLAN_BAD_CHECKSUM, PLAN_BAD_CONTENT
+} plan_status_t;
+
+typedef struct Leg {
+  char waypoint[FLIGHT_PLAN_IDENT_SIZE]; // end of the leg
+  uint16_t planned; // seconds
+  uint16_t burn; // tenths of a fuel unit per hour
+} leg_t;
+
+typedef struct Flight_plan {
+  char departure[FLIGHT_PLAN_IDENT_SIZE];
+  char alternate[FLIGHT_PLAN_IDENT_SIZE];
+  uint16_t fuel; // on board at take-off, tenths of a fuel unit
+  uint16_t reserve_burn; // tenths of a fuel unit per hour once the route is flown
+  uint16_t alternate_time; // seconds
+  uint8_t leg_count;
+  leg_t legs[FLIGHT_PLAN_MAX_LEGS];
+} flight_plan_t;
+
+void flight_plan_init();
+// A plan is flown once: it is used at the on-block of the sector it was
+// loaded for and reads as not loaded from then on, until the next import
+bool flight_plan_is_loaded();
+void flight_plan_set_used(bool used);
+const flight_plan_t *flight_plan_get();
+time_t flight_plan_get_endurance();
+time_t flight_plan_get_duration();
+
+plan_status_t flight_plan_import(const uint8_t *data, uint16_t length);
+void flight_plan_handle_message(DictionaryIterator *iter);
@@ -0,0 +1,35 @@
+#include <pebble.h>
+#include "glance.h"
+
+#if PBL_API_EXISTS(app_glance_reload)
+
+static glance_slice_t s_slices[GLANCE_MAX_SLICES];
+static uint8_t s_count;
+
+static void reload_callback(AppGlanceReloadSession *session, size_t limit, void *context) {
+  for (uint8_t i = 0; i < s_count && i < limit; i++) {
+    AppGlanceResult result = app_glance_add_slice(session, (AppGlanceSlice) {
+      .layout = {
+        .icon = APP_GLANCE_SLICE_DEFAULT_ICON,
+        .subtitle_template_string = s_slices[i].subtitle,
+      },
+      .expiration_time = s_slices[i].expiration != 0 ? s_slices[i].expiration : APP_GLANCE_SLICE_NO_EXPIRATION,
+    });
+    if (result != APP_GLANCE_RESULT_SUCCESS) {
+      APP_LOG(APP_LOG_LEVEL_WARNING, "Glance slice %d rejected: %d", i, (int)result);
+    }
+  }
+}
+
+void glance_publish(const glance_slice_t slices[], uint8_t count) {
+  s_count = count < GLANCE_MAX_SLICES ? count : GLANCE_MAX_SLICES;
+  memcpy(s_slices, slices, s_count * sizeof(glance_slice_t));
+  app_glance_reload(reload_callback, NULL);
+}
+
+#else
+
+// No launcher glance on aplite
+void glance_publish(const glance_slice_t slices[], uint8_t count) {}
+
+#endif
@@ -0,0 +1,16 @@
+#pragma once
+#include <pebble.h>
+
+// App glance shown by the launcher. The subtitles are glance templates, so
+// the system keeps countdowns and elapsed times live while the app is closed.
+#define GLANCE_MAX_SLICES 2
+#define GLANCE_SUBTITLE_SIZE 96
+
+typedef struct Glance_slice {
+  char subtitle[GLANCE_SUBTITLE_SIZE];
+  time_t expiration; // 0 never expires
+} glance_slice_t;
+
+// Replaces the slices, none restores the default glance. Slices that expire
+// make way for the next ones.
+void glance_publish(const glance_slice_t slices[], uint8_t count);
@@ -0,0 +1,34 @@
+#include <pebble.h>
+#include "heap_guard.h"
+
+// Pending app timers also take a few bytes of the app heap
+#define HEAP_GUARD_SLACK 128
+
+static bool s_armed = false;
+static size_t s_baseline;
+static uint16_t s_violations = 0;
+
+void heap_guard_arm() {
+  s_baseline = heap_bytes_used();
+  s_armed = true;
+}
+
+void heap_guard_disarm() {
+  s_armed = false;
+}
+
+void heap_guard_check() {
+  if (!s_armed) {
+    return;
+  }
+  size_t used = heap_bytes_used();
+  if (used > s_baseline + HEAP_GUARD_SLACK) {
+    s_violations++;
+    APP_LOG(APP_LOG_LEVEL_ERROR, "Heap grew by %d bytes in flight (%d times)", (int)(used - s_baseline), s_violations);
+    s_baseline = used;
+  }
+}
+
+uint16_t heap_guard_violations() {
+  return s_violations;
+}
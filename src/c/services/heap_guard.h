@@ -0,0 +1,9 @@
+#pragma once
+#include <pebble.h>
+
+// Debug check that nothing is left allocated on the app heap while armed,
+// i.e. in flight: every window and layer is created at startup.
+void heap_guard_arm();
+void heap_guard_disarm();
+void heap_guard_check();
+uint16_t heap_guard_violations();
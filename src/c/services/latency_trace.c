@@ -0,0 +1,177 @@
+#include <pebble.h>
+#include "latency_trace.h"
+
+#if LATENCY_TRACE
+
+#define LATENCY_TRACE_SIZE 32
+#define UNSET 0xFFFF
+
+// Bucket upper bounds in ms, the last bucket takes everything above
+static const uint16_t s_bounds[] = { 20, 50, 100, 200, 400, 800 };
+#define BUCKET_COUNT (ARRAY_LENGTH(s_bounds) + 1)
+
+typedef enum Span {
+  SPAN_PRESS_TO_CLICK, SPAN_CLICK_TO_STATE, SPAN_STATE_TO_FRAME, SPAN_PRESS_TO_FRAME, SPAN_COUNT
+} span_t;
+
+static const char *s_span_names[SPAN_COUNT] = { "press>click", "click>state", "state>frame", "press>frame" };
+
+// Times in ms since the press, UNSET until reached
+typedef struct Sample {
+  uint32_t press;
+  uint16_t click;
+  uint16_t state;
+  uint16_t frame;
+  uint8_t button;
+  bool long_click;
+} sample_t;
+
+static sample_t s_ring[LATENCY_TRACE_SIZE];
+static uint8_t s_count = 0;
+static uint8_t s_head = 0;
+static sample_t s_open;
+static bool s_is_open = false;
+static uint32_t s_press[NUM_BUTTONS];
+static Layer *s_frame_layer;
+
+static uint32_t now_ms() {
+  time_t seconds;
+  uint16_t ms;
+  time_ms(&seconds, &ms);
+  return seconds * 1000 + ms;
+}
+
+static uint16_t since_press(uint32_t now) {
+  uint32_t delta = now - s_open.press;
+  return delta < UNSET ? delta : UNSET - 1;
+}
+
+static void close_sample() {
+  s_ring[s_head] = s_open;
+  s_head = (s_head + 1) % LATENCY_TRACE_SIZE;
+  if (s_count < LATENCY_TRACE_SIZE) {
+    s_count++;
+  }
+  s_is_open = false;
+  if (s_head == 0) {
+    latency_trace_dump();
+  }
+}
+
+static void raw_down_handler(ClickRecognizerRef recognizer, void *context) {
+  s_press[click_recognizer_get_button_id(recognizer)] = now_ms();
+}
+
+// Drawn last, so it runs once the rest of the window has been rendered
+static void frame_update_proc(Layer *layer, GContext *ctx) {
+  if (s_is_open) {
+    s_open.frame = since_press(now_ms());
+    close_sample();
+  }
+}
+
+void latency_trace_subscribe() {
+  window_raw_click_subscribe(BUTTON_ID_UP, raw_down_handler, NULL, NULL);
+  window_raw_click_subscribe(BUTTON_ID_SELECT, raw_down_handler, NULL, NULL);
+  window_raw_click_subscribe(BUTTON_ID_DOWN, raw_down_handler, NULL, NULL);
+}
+
+void latency_trace_attach(Layer *window_layer) {
+  s_frame_layer = layer_create(layer_get_bounds(window_layer));
+  layer_set_update_proc(s_frame_layer, frame_update_proc);
+  layer_add_child(window_layer, s_frame_layer);
+}
+
+void latency_trace_detach() {
+  latency_trace_dump();
+  layer_destroy(s_frame_layer);
+  s_frame_layer = NULL;
+}
+
+void latency_trace_click(ClickRecognizerRef recognizer, bool long_click) {
+  if (s_is_open) {
+    // No frame since the previous click, keep it without one
+    close_sample();
+  }
+  ButtonId button = click_recognizer_get_button_id(recognizer);
+  uint32_t now = now_ms();
+  
+  s_open = (sample_t) {
+    .press = s_press[button] != 0 ? s_press[button] : now,
+    .state = UNSET,
+    .frame = UNSET,
+    .button = button,
+    .long_click = long_click
+  };
+  s_open.click = since_press(now);
+  s_is_open = true;
+  
+  // Nothing may change on screen, the frame is still worth timing
+  layer_mark_dirty(s_frame_layer);
+}
+
+void latency_trace_state() {
+  if (s_is_open && s_open.state == UNSET) {
+    s_open.state = since_press(now_ms());
+  }
+}
+
+static uint16_t span(const sample_t *sample, span_t which) {
+  switch (which) {
+    case SPAN_PRESS_TO_CLICK:
+      return sample->click;
+    case SPAN_CLICK_TO_STATE:
+      return sample->state == UNSET ? UNSET : sample->state - sample->click;
+    case SPAN_STATE_TO_FRAME:
+      return sample->state == UNSET || sample->frame == UNSET ? UNSET : sample->frame - sample->state;
+    case SPAN_PRESS_TO_FRAME:
+      return sample->frame;
+    default:
+      return UNSET;
+  }
+}
+
+static void dump_histogram(bool long_click) {
+  for (int s = 0; s < SPAN_COUNT; s++) {
+    uint8_t buckets[BUCKET_COUNT] = { 0 };
+    int n = 0;
+    uint32_t total = 0;
+    uint16_t max = 0;
+    
+    for (int i = 0; i < s_count; i++) {
+      if (s_ring[i].long_click != long_click) {
+        continue;
+      }
+      uint16_t value = span(&s_ring[i], s);
+      if (value == UNSET) {
+        continue;
+      }
+      unsigned int b = 0;
+      while (b < ARRAY_LENGTH(s_bounds) && value > s_bounds[b]) {
+        b++;
+      }
+      buckets[b]++;
+      total += value;
+      max = value > max ? value : max;
+      n++;
+    }
+    if (n == 0) {
+      continue;
+    }
+    
+    APP_LOG(APP_LOG_LEVEL_INFO, "%s %-11s n=%d avg=%d max=%d | <20:%d <50:%d <100:%d <200:%d <400:%d <800:%d more:%d",
+            long_click ? "long " : "short", s_span_names[s], n, (int)(total / n), max,
+            buckets[0], buckets[1], buckets[2], buckets[3], buckets[4], buckets[5], buckets[6]);
+  }
+}
+
+void latency_trace_dump() {
+  if (s_count == 0) {
+    return;
+  }
+  APP_LOG(APP_LOG_LEVEL_INFO, "Latency over the last %d clicks (ms)", s_count);
+  dump_histogram(false);
+  dump_histogram(true);
+}
+
+#endif
@@ -0,0 +1,32 @@
+#pragma once
+#include <pebble.h>
+
+// Opt-in input latency trace, build with -DLATENCY_TRACE=1. Each click is
+// timed from the button press to the handler (long-click disambiguation),
+// to the resulting state change and to the end of the next frame. A latency
+// histogram is logged every LATENCY_TRACE_SIZE clicks and on exit.
+#ifndef LATENCY_TRACE
+#define LATENCY_TRACE 0
+#endif
+
+#if LATENCY_TRACE
+
+// From the click config provider, times the button presses
+void latency_trace_subscribe();
+// Adds the layer marking the end of each frame, on top of the window
+void latency_trace_attach(Layer *window_layer);
+void latency_trace_detach();
+void latency_trace_click(ClickRecognizerRef recognizer, bool long_click);
+void latency_trace_state();
+void latency_trace_dump();
+
+#else
+
+static inline void latency_trace_subscribe() {}
+static inline void latency_trace_attach(Layer *window_layer) {}
+static inline void latency_trace_detach() {}
+static inline void latency_trace_click(ClickRecognizerRef recognizer, bool long_click) {}
+static inline void latency_trace_state() {}
+static inline void latency_trace_dump() {}
+
+#endif
@@ -0,0 +1,238 @@
+#include <pebble.h>
+#include "logbook.h"
+#include "sun.h"
+#include "../utils.h"
+#include "../persist_keys.h"
+
+// The logbook is a ring of persisted slots, the oldest flights are
+// overwritten once it is full. One spare slot is kept so that dropping the
+// last flight never loses the one it replaced.
+//
+// The phone sends corrected times as one byte array, little-endian:
+//   uint8 version, uint16 number, uint16 sequence the phone edited,
+//   uint32 off-block, take-off, landing, on-block,
+//   uint16 Fletcher-16 checksum of everything before it.
+// A patch made on an older copy of the flight than the watch holds is
+// refused, the phone gets the flight again on its next sync.
+#define LOGBOOK_SLOTS (LOGBOOK_CAPACITY + 1)
+#define PATCH_VERSION 1
+#define PATCH_SIZE 23
+#define PATCH_REPLY_RETRIES 3
+
+typedef struct Logbook_header {
+  uint16_t total; // flights ever appended, the next one goes to total % LOGBOOK_SLOTS
+  uint16_t sequence; // last sequence number given
+  uint16_t synced; // last sequence number the phone confirmed
+} logbook_header_t;
+
+static logbook_header_t s_header;
+static int16_t s_dirty_count = -1; // worked out when first asked for
+
+// The phone sends the next patch on the reply, so a reply that cannot leave
+// is kept until the outbox is free again
+typedef struct Patch_reply {
+  bool pending;
+  uint8_t status;
+  uint16_t sequence;
+  uint8_t retries;
+} patch_reply_t;
+
+static patch_reply_t s_patch_reply;
+
+static void write_header() {
+  persist_write_data(PERSIST_KEY_LOGBOOK_HEADER, &s_header, sizeof(s_header));
+}
+
+static void write_flight(const flight_t *flight) {
+  persist_write_data(PERSIST_KEY_LOGBOOK_BASE + flight->number % LOGBOOK_SLOTS, flight, sizeof(flight_t));
+}
+
+// Headers from before the sync count each flight appended as one change
+void logbook_init() {
+  s_header = (logbook_header_t) { 0 };
+  if (persist_exists(PERSIST_KEY_LOGBOOK_HEADER)
+      && persist_read_data(PERSIST_KEY_LOGBOOK_HEADER, &s_header, sizeof(s_header)) < (int)sizeof(s_header)) {
+    s_header.sequence = s_header.total;
+    s_header.synced = 0;
+  }
+}
+
+uint16_t logbook_count() {
+  return s_header.total < LOGBOOK_CAPACITY ? s_header.total : LOGBOOK_CAPACITY;
+}
+
+// index 0 is the oldest flight still stored
+bool logbook_read(uint16_t index, flight_t *flight) {
+  if (index >= logbook_count()) {
+    return false;
+  }
+  uint16_t number = s_header.total - logbook_count() + index;
+  memset(flight, 0, sizeof(flight_t));
+  int length = persist_read_data(PERSIST_KEY_LOGBOOK_BASE + number % LOGBOOK_SLOTS, flight, sizeof(flight_t));
+  if (length < (int)(offsetof(flight_t, night) + sizeof(flight->night))) {
+    flight->night = FLIGHT_NIGHT_UNKNOWN;
+  }
+  if (length < (int)(offsetof(flight_t, sequence) + sizeof(flight->sequence))) {
+    flight->sequence = number + 1;
+  }
+  flight->number = number;
+  return length > 0;
+}
+
+bool logbook_find(uint16_t number, flight_t *flight) {
+  uint16_t first = s_header.total - logbook_count();
+  return number >= first && logbook_read(number - first, flight);
+}
+
+void logbook_append(const flight_t *flight) {
+  flight_t record = *flight;
+  record.number = s_header.total;
+  record.sequence = ++s_header.sequence;
+  write_flight(&record);
+  s_header.total++;
+  write_header();
+  s_dirty_count = -1;
+}
+
+// Used when the on-block transition is cancelled, the slot is simply reused.
+// The sequence number is not given back: if the phone already got the
+// flight, the next one appended replaces it there.
+void logbook_drop_last() {
+  if (s_header.total > 0) {
+    s_header.total--;
+    write_header();
+    s_dirty_count = -1;
+  }
+}
+
+uint16_t logbook_sequence() {
+  return s_header.sequence;
+}
+
+uint16_t logbook_synced() {
+  return s_header.synced;
+}
+
+void logbook_set_synced(uint16_t sequence) {
+  if (sequence > s_header.synced) {
+    s_header.synced = sequence;
+    write_header();
+    s_dirty_count = -1;
+  }
+}
+
+bool logbook_is_dirty(const flight_t *flight) {
+  return flight->sequence > s_header.synced;
+}
+
+uint16_t logbook_dirty_count() {
+  if (s_dirty_count < 0) {
+    flight_t flight;
+    s_dirty_count = 0;
+    for (uint16_t i = 0; i < logbook_count(); i++) {
+      if (logbook_read(i, &flight) && logbook_is_dirty(&flight)) {
+        s_dirty_count++;
+      }
+    }
+  }
+  return s_dirty_count;
+}
+
+// Best effort, the night time is kept if an airport is not in the table
+static void update_night(flight_t *flight) {
+  char departure[LOGBOOK_IDENT_SIZE + 1] = "";
+  char destination[LOGBOOK_IDENT_SIZE + 1] = "";
+  strncpy(departure, flight->departure, LOGBOOK_IDENT_SIZE);
+  strncpy(destination, flight->destination, LOGBOOK_IDENT_SIZE);
+  if (departure[0] == '\0' || destination[0] == '\0') {
+    return;
+  }
+  time_t night = sun_night_time(departure, destination, flight->off_block, flight->on_block);
+  if (night >= 0) {
+    flight->night = night / SECONDS_PER_MINUTE;
+  }
+}
+
+patch_status_t logbook_patch(const uint8_t *data, uint16_t length) {
+  if (length != PATCH_SIZE) {
+    return PATCH_BAD_LENGTH;
+  }
+  if (data[0] != PATCH_VERSION) {
+    return PATCH_BAD_VERSION;
+  }
+  if (fletcher16(data, length - 2) != read_uint16(data + length - 2)) {
+    return PATCH_BAD_CHECKSUM;
+  }
+
+  uint32_t off_block = read_uint32(data + 5);
+  uint32_t take_off = read_uint32(data + 9);
+  uint32_t landing = read_uint32(data + 13);
+  uint32_t on_block = read_uint32(data + 17);
+  if (off_block == 0 || take_off < off_block || landing < take_off || on_block < landing) {
+    return PATCH_BAD_VALUE;
+  }
+
+  flight_t flight;
+  if (!logbook_find(read_uint16(data + 1), &flight)) {
+    return PATCH_UNKNOWN;
+  }
+  if (flight.sequence != read_uint16(data + 3)) {
+    return PATCH_CONFLICT;
+  }
+
+  flight.off_block = off_block;
+  flight.take_off = take_off;
+  flight.landing = landing;
+  flight.on_block = on_block;
+  flight.flags |= FLIGHT_EDITED;
+  update_night(&flight);
+
+  // Dirty again: the next sync sends it back with the night time worked
+  // out here
+  flight.sequence = ++s_header.sequence;
+  write_flight(&flight);
+  write_header();
+  s_dirty_count = -1;
+  return PATCH_OK;
+}
+
+static void send_patch_reply() {
+  DictionaryIterator *reply;
+  if (app_message_outbox_begin(&reply) != APP_MSG_OK) {
+    APP_LOG(APP_LOG_LEVEL_WARNING, "Logbook patch reply deferred, outbox busy");
+    return;
+  }
+  dict_write_uint8(reply, MESSAGE_KEY_Patch, s_patch_reply.status);
+  dict_write_uint16(reply, MESSAGE_KEY_Sequence, s_patch_reply.sequence);
+  if (app_message_outbox_send() == APP_MSG_OK) {
+    s_patch_reply.pending = false;
+  }
+}
+
+void logbook_handle_patch(DictionaryIterator *iter) {
+  Tuple *tuple = dict_find(iter, MESSAGE_KEY_Patch);
+  patch_status_t status = tuple->type == TUPLE_BYTE_ARRAY ? logbook_patch(tuple->value->data, tuple->length) : PATCH_BAD_LENGTH;
+  if (status != PATCH_OK) {
+    APP_LOG(APP_LOG_LEVEL_WARNING, "Logbook patch rejected: %d", (int)status);
+  }
+
+  s_patch_reply = (patch_reply_t) { .pending = true, .status = status, .sequence = s_header.sequence };
+  send_patch_reply();
+}
+
+void logbook_outbox_sent(DictionaryIterator *iter) {
+  if (s_patch_reply.pending) {
+    send_patch_reply();
+  }
+}
+
+void logbook_outbox_failed(DictionaryIterator *iter) {
+  if (dict_find(iter, MESSAGE_KEY_Patch) != NULL) {
+    if (++s_patch_reply.retries > PATCH_REPLY_RETRIES) {
+      APP_LOG(APP_LOG_LEVEL_WARNING, "Logbook patch reply dropped");
+      return;
+    }
+    s_patch_reply.pending = true;
+  }
+  logbook_outbox_sent(iter);
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include <pebble.h>
+#define LOGBOOK_CAPACITY 32
+#define LOGBOOK_IDENT_SIZE 4
+#define FLIGHT_NIGHT_UNKNOWN 0xFFFF
+#define FLIGHT_EDITED 0x01 // times corrected on the phone
+
+// One completed flight as stored on the watch and sent to the phone.
+// Packed little-endian, the phone side decodes it byte by byte. New fields
+// go at the end: shorter records stored by older versions read as zeros.
+typedef struct __attribute__((__packed__)) Flight {
+  uint32_t off_block;
+  uint32_t take_off;
+  uint32_t landing;
+  uint32_t on_block;
+  uint16_t endurance; // minutes at take-off, 0 if not entered
+  uint16_t night; // minutes of block time at night
+  char departure[LOGBOOK_IDENT_SIZE]; // not NUL-terminated, empty if unknown
+  char destination[LOGBOOK_IDENT_SIZE];
+  uint8_t landings; // touch-and-go and full stop
+  uint16_t number; // flights appended before this one, identifies it on the phone
+  uint16_t sequence; // logbook sequence number of its last change
+  uint8_t flags;
+} flight_t;
+
+typedef enum Patch_status {
+  PATCH_OK, PATCH_BAD_LENGTH, PATCH_BAD_VERSION, PATCH_BAD_CHECKSUM, PATCH_BAD_VALUE, PATCH_UNKNOWN, PATCH_CONFLICT
+} patch_status_t;
+
+void logbook_init();
+
+uint16_t logbook_count();
+bool logbook_read(uint16_t index, flight_t *flight);
+bool logbook_find(uint16_t number, flight_t *flight);
+void logbook_append(const flight_t *flight);
+void logbook_drop_last();
+
+// Every append or patch takes the next sequence number. The phone holds
+// every change up to the synced one, the flights changed since are dirty.
+uint16_t logbook_sequence();
+uint16_t logbook_synced();
+void logbook_set_synced(uint16_t sequence);
+bool logbook_is_dirty(const flight_t *flight);
+uint16_t logbook_dirty_count();
+
+patch_status_t logbook_patch(const uint8_t *data, uint16_t length);
+void logbook_handle_patch(DictionaryIterator *iter);
+// The patch reply waits for a busy outbox, any message leaving frees it
+void logbook_outbox_sent(DictionaryIterator *iter);
+void logbook_outbox_failed(DictionaryIterator *iter);
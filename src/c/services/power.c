@@ -0,0 +1,204 @@
+#include <pebble.h>
+#include "power.h"
+
+// Rough currents of the watch, in uA, and charges in uA.s per event
+#define POWER_BASE_UA 500 // app open, screen static
+#define POWER_TICK_UAS 50 // wake-up and redraw
+#define POWER_VIBE_UA 50000 // motor running
+#define POWER_LIGHT_UAS (10000 * 3) // backlight on for about 3 s
+#define POWER_TENTHS_MS 100
+
+typedef struct Power_profile {
+  const char *name;
+  TimeUnits tick_unit;
+  uint32_t stopwatch_ms; // without tenths
+  bool stopwatch_tenths; // shown when asked for
+  bool alarm_light;
+  uint16_t reminder_interval; // minimum seconds between two reminders
+  VibePattern vibes[VIBE_KIND_COUNT];
+} power_profile_t;
+
+static const uint32_t s_short[] = { 100 };
+static const uint32_t s_double[] = { 100, 100, 100 };
+static const uint32_t s_long[] = { 500 };
+static const uint32_t s_soft[] = { 40 };
+static const uint32_t s_soft_double[] = { 40, 150, 40 };
+static const uint32_t s_soft_long[] = { 200, 150, 200 };
+
+#define PATTERN(segments) { .durations = segments, .num_segments = ARRAY_LENGTH(segments) }
+
+static const power_profile_t s_profiles[POWER_PROFILE_COUNT] = {
+  [POWER_PROFILE_DAY] = {
+    .name = "Day",
+    .tick_unit = SECOND_UNIT,
+    .stopwatch_ms = 1000,
+    .stopwatch_tenths = true,
+    .alarm_light = true,
+    .reminder_interval = 0,
+    .vibes = { PATTERN(s_short), PATTERN(s_short), PATTERN(s_double), PATTERN(s_long) }
+  },
+  // Dark cockpit: no light, brief pulses and fewer reminders
+  [POWER_PROFILE_NIGHT] = {
+    .name = "Night",
+    .tick_unit = SECOND_UNIT,
+    .stopwatch_ms = 1000,
+    .stopwatch_tenths = true,
+    .alarm_light = false,
+    .reminder_interval = 2 * SECONDS_PER_MINUTE,
+    .vibes = { PATTERN(s_soft), PATTERN(s_soft), PATTERN(s_soft_double), PATTERN(s_soft_long) }
+  },
+  // As night, with the screen and the stopwatch updated once a minute
+  [POWER_PROFILE_SAVER] = {
+    .name = "Saver",
+    .tick_unit = MINUTE_UNIT,
+    .stopwatch_ms = SECONDS_PER_MINUTE * 1000,
+    .stopwatch_tenths = false,
+    .alarm_light = false,
+    .reminder_interval = 5 * SECONDS_PER_MINUTE,
+    .vibes = { PATTERN(s_soft), PATTERN(s_soft), PATTERN(s_soft_double), PATTERN(s_soft_long) }
+  }
+};
+
+static power_profile_id_t s_current = POWER_PROFILE_DAY;
+static TickHandler s_tick_handler;
+
+// Every request is played against every profile, so that all the estimates
+// come from the same flight
+typedef struct Power_usage {
+  uint32_t vibe_ms;
+  uint16_t lights;
+  time_t last_reminder;
+} power_usage_t;
+
+static power_usage_t s_usage[POWER_PROFILE_COUNT];
+static time_t s_since;
+
+// Seconds the stopwatch was on screen, and of those with tenths asked for
+static time_t s_stopwatch_shown;
+static time_t s_stopwatch_tenths;
+static time_t s_stopwatch_since; // 0 while hidden
+static bool s_stopwatch_tenths_on;
+
+static uint32_t pattern_ms(const VibePattern *pattern) {
+  uint32_t ms = 0;
+  // Even segments are on, odd ones are pauses
+  for (uint32_t i = 0; i < pattern->num_segments; i += 2) {
+    ms += pattern->durations[i];
+  }
+  return ms;
+}
+
+static bool reminder_allowed(power_profile_id_t profile, time_t now) {
+  power_usage_t *usage = &s_usage[profile];
+  if (usage->last_reminder != 0 && now - usage->last_reminder < s_profiles[profile].reminder_interval) {
+    return false;
+  }
+  usage->last_reminder = now;
+  return true;
+}
+
+void power_init(TickHandler handler) {
+  s_tick_handler = handler;
+  s_since = time(NULL);
+  tick_timer_service_subscribe(s_profiles[s_current].tick_unit, s_tick_handler);
+}
+
+void power_deinit() {
+  tick_timer_service_unsubscribe();
+  for (int profile = 0; profile < POWER_PROFILE_COUNT; profile++) {
+    uint32_t estimate = power_get_estimate(profile);
+    APP_LOG(APP_LOG_LEVEL_INFO, "Power %s: %d.%02d mAh/h", s_profiles[profile].name,
+            (int)(estimate / 1000), (int)(estimate % 1000 / 10));
+  }
+}
+
+void power_set_profile(power_profile_id_t profile) {
+  if (s_profiles[profile].tick_unit != s_profiles[s_current].tick_unit) {
+    tick_timer_service_subscribe(s_profiles[profile].tick_unit, s_tick_handler);
+  }
+  s_current = profile;
+}
+
+uint32_t power_get_stopwatch_period(bool tenths) {
+  return tenths && s_profiles[s_current].stopwatch_tenths ? POWER_TENTHS_MS : s_profiles[s_current].stopwatch_ms;
+}
+
+static void stopwatch_time(time_t now, time_t *shown, time_t *tenths) {
+  *shown = s_stopwatch_shown;
+  *tenths = s_stopwatch_tenths;
+  if (s_stopwatch_since != 0) {
+    *shown += now - s_stopwatch_since;
+    if (s_stopwatch_tenths_on) {
+      *tenths += now - s_stopwatch_since;
+    }
+  }
+}
+
+void power_set_stopwatch(bool shown, bool tenths) {
+  time_t now = time(NULL);
+  stopwatch_time(now, &s_stopwatch_shown, &s_stopwatch_tenths);
+  s_stopwatch_since = shown ? now : 0;
+  s_stopwatch_tenths_on = tenths;
+}
+
+power_profile_id_t power_get_profile() {
+  return s_current;
+}
+
+const char *power_get_name(power_profile_id_t profile) {
+  return s_profiles[profile].name;
+}
+
+void power_vibe(vibe_kind_t kind) {
+  time_t now = time(NULL);
+  bool play = false;
+  
+  for (int profile = 0; profile < POWER_PROFILE_COUNT; profile++) {
+    bool allowed = kind != VIBE_REMINDER || reminder_allowed(profile, now);
+    if (allowed) {
+      s_usage[profile].vibe_ms += pattern_ms(&s_profiles[profile].vibes[kind]);
+    }
+    if (profile == (int)s_current) {
+      play = allowed;
+    }
+  }
+  
+  if (play) {
+    vibes_enqueue_custom_pattern(s_profiles[s_current].vibes[kind]);
+  }
+}
+
+void power_light() {
+  for (int profile = 0; profile < POWER_PROFILE_COUNT; profile++) {
+    if (s_profiles[profile].alarm_light) {
+      s_usage[profile].lights++;
+    }
+  }
+  if (s_profiles[s_current].alarm_light) {
+    light_enable_interaction();
+  }
+}
+
+uint32_t power_get_estimate(power_profile_id_t profile) {
+  const power_profile_t *definition = &s_profiles[profile];
+  const power_usage_t *usage = &s_usage[profile];
+  uint32_t elapsed = time(NULL) - s_since;
+  if (elapsed == 0) {
+    elapsed = 1;
+  }
+  
+  uint32_t ticks = definition->tick_unit == SECOND_UNIT ? elapsed : elapsed / SECONDS_PER_MINUTE;
+  
+  // The stopwatch runs its own timer while on screen
+  time_t shown, tenths;
+  stopwatch_time(time(NULL), &shown, &tenths);
+  uint32_t tenths_ms = definition->stopwatch_tenths ? POWER_TENTHS_MS : definition->stopwatch_ms;
+  ticks += (uint64_t)(shown - tenths) * 1000 / definition->stopwatch_ms
+    + (uint64_t)tenths * 1000 / tenths_ms;
+  
+  uint64_t charge = (uint64_t)POWER_BASE_UA * elapsed
+    + (uint64_t)POWER_TICK_UAS * ticks
+    + (uint64_t)POWER_VIBE_UA * usage->vibe_ms / 1000
+    + (uint64_t)POWER_LIGHT_UAS * usage->lights;
+  return charge / elapsed;
+}
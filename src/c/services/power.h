@@ -0,0 +1,38 @@
+#pragma once
+#include <pebble.h>
+
+// Power profiles govern the vibrations, the backlight on alarms, the tick
+// rate and the stopwatch updates together. Every vibration of the app goes through power_vibe.
+typedef enum Power_profile_id {
+  POWER_PROFILE_DAY, POWER_PROFILE_NIGHT, POWER_PROFILE_SAVER, POWER_PROFILE_COUNT
+} power_profile_id_t;
+
+typedef enum Vibe_kind {
+  VIBE_REMINDER, // repeated while taxiing, rate-limited by the profile
+  VIBE_NOTICE, // leg end, touch-and-go, checklist done
+  VIBE_ALARM,
+  VIBE_WARNING, // important alarm
+  VIBE_KIND_COUNT
+} vibe_kind_t;
+
+// Subscribes handler to the tick service at the rate of the profile
+void power_init(TickHandler handler);
+void power_deinit();
+
+void power_set_profile(power_profile_id_t profile);
+power_profile_id_t power_get_profile();
+const char *power_get_name(power_profile_id_t profile);
+
+// Stopwatch update period in ms, with tenths if asked for and the profile
+// allows them: Saver updates it once a minute, without tenths
+uint32_t power_get_stopwatch_period(bool tenths);
+// Time on screen of the stopwatch, its wake-ups count in the estimates
+void power_set_stopwatch(bool shown, bool tenths);
+
+void power_vibe(vibe_kind_t kind);
+// Lights the screen for an alarm if the profile allows it
+void power_light();
+
+// Average current in uA, i.e. uAh per hour, if the profile had been used
+// since launch. Rough figures, good for comparing the profiles.
+uint32_t power_get_estimate(power_profile_id_t profile);
@@ -0,0 +1,46 @@
+#include <pebble.h>
+#include "profile.h"
+
+#if PROFILE
+
+static profile_stats_t s_stats[PROFILE_COUNT];
+
+static const char *s_names[PROFILE_COUNT] = {
+  "Tick", "Clock", "Mission", "Endurance", "Nav log", "Stopwatch",
+  "Draw battery", "Draw endurance", "Draw digits", "Draw entry", "Draw timeline"
+};
+
+uint32_t profile_now() {
+  time_t seconds;
+  uint16_t ms;
+  time_ms(&seconds, &ms);
+  return seconds * 1000 + ms;
+}
+
+void profile_record(profile_probe_t probe, uint32_t start) {
+  uint32_t duration = profile_now() - start;
+  profile_stats_t *stats = &s_stats[probe];
+  
+  if (stats->count == 0 || duration < stats->min_ms) {
+    stats->min_ms = duration;
+  }
+  if (duration > stats->max_ms) {
+    stats->max_ms = duration;
+  }
+  stats->total_ms += duration;
+  stats->count++;
+}
+
+const profile_stats_t *profile_get(profile_probe_t probe) {
+  return &s_stats[probe];
+}
+
+const char *profile_get_name(profile_probe_t probe) {
+  return s_names[probe];
+}
+
+void profile_reset() {
+  memset(s_stats, 0, sizeof(s_stats));
+}
+
+#endif
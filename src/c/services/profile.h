@@ -0,0 +1,44 @@
+#pragma once
+#include <pebble.h>
+
+// Call counts and durations of the tick handler, the component updates and
+// the layer update procs, shown by the debug window. Build with -DPROFILE=1,
+// otherwise PROFILE_CALL is the bare call and nothing else is compiled in.
+#ifndef PROFILE
+#define PROFILE 0
+#endif
+
+typedef enum Profile_probe {
+  PROFILE_TICK, PROFILE_CLOCK, PROFILE_MISSION, PROFILE_ENDURANCE, PROFILE_NAVLOG, PROFILE_ET,
+  PROFILE_DRAW_BATTERY, PROFILE_DRAW_ENDURANCE, PROFILE_DRAW_DIGITS, PROFILE_DRAW_ENTRY, PROFILE_DRAW_TIMELINE,
+  PROFILE_COUNT
+} profile_probe_t;
+
+// Durations are in ms, the resolution of time_ms. Short calls mostly read 0
+// or 1 ms, the average over many calls is still meaningful.
+typedef struct Profile_stats {
+  uint32_t count;
+  uint32_t total_ms;
+  uint16_t min_ms;
+  uint16_t max_ms;
+} profile_stats_t;
+
+#if PROFILE
+
+#define PROFILE_CALL(probe, call) do { \
+    uint32_t profile_start = profile_now(); \
+    call; \
+    profile_record(probe, profile_start); \
+  } while (0)
+
+uint32_t profile_now();
+void profile_record(profile_probe_t probe, uint32_t start);
+const profile_stats_t *profile_get(profile_probe_t probe);
+const char *profile_get_name(profile_probe_t probe);
+void profile_reset();
+
+#else
+
+#define PROFILE_CALL(probe, call) call
+
+#endif
@@ -0,0 +1,142 @@
+#include <pebble.h>
+#include "settings.h"
+#include "../utils.h"
+#include "../persist_keys.h"
+
+// The settings are persisted as one struct, tagged with a version so a
+// layout change falls back to the defaults instead of misreading them.
+// The phone sends them as one byte array, little-endian:
+//   uint8 version, SETTING_COUNT * uint16 value (s),
+//   uint16 Fletcher-16 checksum of everything before it.
+
+#define SETTINGS_VERSION 1
+#define SETTINGS_BLOB_SIZE (1 + SETTING_COUNT * 2 + 2)
+
+typedef struct Setting_def {
+  const char *name;
+  uint16_t value; // default
+  uint16_t min;
+  uint16_t max;
+} setting_def_t;
+
+static const setting_def_t s_defs[SETTING_COUNT] = {
+  [SETTING_CRUISE_CHECK_INTERVAL] = { "Cruise check", 15 * SECONDS_PER_MINUTE, SECONDS_PER_MINUTE, 99 * SECONDS_PER_MINUTE },
+  [SETTING_CRUISE_CHECK_DISPLAY] = { "Cruise check shown", 2 * SECONDS_PER_MINUTE, 5, 99 * SECONDS_PER_MINUTE },
+  [SETTING_RESERVE_ALARM_INTERVAL] = { "Fuel alarm", 15 * SECONDS_PER_MINUTE, SECONDS_PER_MINUTE, 99 * SECONDS_PER_MINUTE },
+  [SETTING_RESERVE_ALARM_DISPLAY] = { "Fuel alarm shown", 15 * SECONDS_PER_MINUTE, 5, 99 * SECONDS_PER_MINUTE },
+  [SETTING_FLIGHT_PLAN_DELAY] = { "Plan closed?", 5 * SECONDS_PER_MINUTE, SECONDS_PER_MINUTE, 99 * SECONDS_PER_MINUTE },
+  [SETTING_FLIGHT_PLAN_DISPLAY] = { "Plan closed? shown", 10 * SECONDS_PER_MINUTE, 5, 99 * SECONDS_PER_MINUTE },
+  [SETTING_BATTERY_ALARM_INTERVAL] = { "Battery alarm", 30 * SECONDS_PER_MINUTE, SECONDS_PER_MINUTE, 99 * SECONDS_PER_MINUTE },
+  [SETTING_BATTERY_ALARM_DISPLAY] = { "Battery alarm shown", 2 * SECONDS_PER_MINUTE, 5, 99 * SECONDS_PER_MINUTE },
+  [SETTING_FUEL_RESERVE] = { "Fuel reserve", 45 * SECONDS_PER_MINUTE, 0, 99 * SECONDS_PER_MINUTE },
+  [SETTING_TAXI_OUT_REMINDER] = { "Taxi out reminder", 30, 5, 99 * SECONDS_PER_MINUTE },
+  [SETTING_TAXI_IN_REMINDER] = { "Taxi in reminder", 60, 5, 99 * SECONDS_PER_MINUTE },
+  [SETTING_INFO_REVERT] = { "Info revert", 3, 1, 5 * SECONDS_PER_MINUTE },
+  [SETTING_INFO_BROWSE_REVERT] = { "Browse revert", 10, 1, 5 * SECONDS_PER_MINUTE },
+};
+
+typedef struct Settings {
+  uint8_t version;
+  uint16_t values[SETTING_COUNT];
+} settings_t;
+
+static settings_t s_settings;
+
+static uint16_t clamp(setting_id_t id, uint16_t value) {
+  return value < s_defs[id].min ? s_defs[id].min : value > s_defs[id].max ? s_defs[id].max : value;
+}
+
+static void set_defaults() {
+  s_settings.version = SETTINGS_VERSION;
+  for (int i = 0; i < SETTING_COUNT; i++) {
+    s_settings.values[i] = s_defs[i].value;
+  }
+}
+
+static void save() {
+  persist_write_data(PERSIST_KEY_SETTINGS, &s_settings, sizeof(s_settings));
+}
+
+void settings_init() {
+  set_defaults();
+  if (!persist_exists(PERSIST_KEY_SETTINGS)) {
+    return;
+  }
+
+  settings_t stored;
+  if (persist_read_data(PERSIST_KEY_SETTINGS, &stored, sizeof(stored)) != sizeof(stored)
+      || stored.version != SETTINGS_VERSION) {
+    APP_LOG(APP_LOG_LEVEL_WARNING, "Settings reset to defaults");
+    return;
+  }
+  for (int i = 0; i < SETTING_COUNT; i++) {
+    s_settings.values[i] = clamp(i, stored.values[i]);
+  }
+}
+
+uint16_t settings_get(setting_id_t id) {
+  return s_settings.values[id];
+}
+
+uint32_t settings_get_ms(setting_id_t id) {
+  return (uint32_t)s_settings.values[id] * 1000;
+}
+
+const char *settings_get_name(setting_id_t id) {
+  return s_defs[id].name;
+}
+
+uint16_t settings_get_min(setting_id_t id) {
+  return s_defs[id].min;
+}
+
+uint16_t settings_get_max(setting_id_t id) {
+  return s_defs[id].max;
+}
+
+void settings_set(setting_id_t id, uint16_t value) {
+  s_settings.values[id] = clamp(id, value);
+  save();
+}
+
+void settings_reset() {
+  set_defaults();
+  persist_delete(PERSIST_KEY_SETTINGS);
+}
+
+settings_status_t settings_import(const uint8_t *data, uint16_t length) {
+  if (length != SETTINGS_BLOB_SIZE) {
+    return SETTINGS_BAD_LENGTH;
+  }
+  if (data[0] != SETTINGS_VERSION) {
+    return SETTINGS_BAD_VERSION;
+  }
+  if (fletcher16(data, length - 2) != read_uint16(data + length - 2)) {
+    return SETTINGS_BAD_CHECKSUM;
+  }
+
+  uint16_t values[SETTING_COUNT];
+  for (int i = 0; i < SETTING_COUNT; i++) {
+    values[i] = read_uint16(data + 1 + i * 2);
+    if (values[i] != clamp(i, values[i])) {
+      return SETTINGS_BAD_VALUE;
+    }
+  }
+  memcpy(s_settings.values, values, sizeof(values));
+  save();
+  return SETTINGS_OK;
+}
+
+void settings_handle_message(DictionaryIterator *iter) {
+  Tuple *tuple = dict_find(iter, MESSAGE_KEY_Settings);
+  settings_status_t status = tuple->type == TUPLE_BYTE_ARRAY ? settings_import(tuple->value->data, tuple->length) : SETTINGS_BAD_LENGTH;
+  if (status != SETTINGS_OK) {
+    APP_LOG(APP_LOG_LEVEL_WARNING, "Settings rejected: %d", (int)status);
+  }
+
+  DictionaryIterator *reply;
+  if (app_message_outbox_begin(&reply) == APP_MSG_OK) {
+    dict_write_uint8(reply, MESSAGE_KEY_Settings, status);
+    app_message_outbox_send();
+  }
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include <pebble.h>
+
+// Alarm and reminder timings, all in seconds. Loaded once at start-up and
+// read from RAM afterwards.
+typedef enum Setting_id {
+  SETTING_CRUISE_CHECK_INTERVAL,
+  SETTING_CRUISE_CHECK_DISPLAY,
+  SETTING_RESERVE_ALARM_INTERVAL,
+  SETTING_RESERVE_ALARM_DISPLAY,
+  SETTING_FLIGHT_PLAN_DELAY,
+  SETTING_FLIGHT_PLAN_DISPLAY,
+  SETTING_BATTERY_ALARM_INTERVAL,
+  SETTING_BATTERY_ALARM_DISPLAY,
+  SETTING_FUEL_RESERVE,
+  SETTING_TAXI_OUT_REMINDER,
+  SETTING_TAXI_IN_REMINDER,
+  SETTING_INFO_REVERT,
+  SETTING_INFO_BROWSE_REVERT,
+  SETTING_COUNT
+} setting_id_t;
+
+typedef enum Settings_status {
+  SETTINGS_OK, SETTINGS_BAD_LENGTH, SETTINGS_BAD_VERSION, SETTINGS_BAD_CHECKSUM, SETTINGS_BAD_VALUE
+} settings_status_t;
+
+void settings_init();
+
+uint16_t settings_get(setting_id_t id);
+uint32_t settings_get_ms(setting_id_t id);
+const char *settings_get_name(setting_id_t id);
+uint16_t settings_get_min(setting_id_t id);
+uint16_t settings_get_max(setting_id_t id);
+
+// Clamps the value to the range of the setting and persists the settings
+void settings_set(setting_id_t id, uint16_t value);
+void settings_reset();
+
+settings_status_t settings_import(const uint8_t *data, uint16_t length);
+void settings_handle_message(DictionaryIterator *iter);
@@ -0,0 +1,29 @@
+#include <pebble.h>
+#include "startup_trace.h"
+
+#if STARTUP_TRACE
+
+static uint32_t s_launch;
+static uint32_t s_marks[STARTUP_MARK_COUNT];
+
+static uint32_t now_ms() {
+  time_t seconds;
+  uint16_t ms;
+  time_ms(&seconds, &ms);
+  return seconds * 1000 + ms;
+}
+
+void startup_trace_begin() {
+  s_launch = now_ms();
+}
+
+void startup_trace_mark(startup_mark_t mark) {
+  s_marks[mark] = now_ms() - s_launch;
+  if (mark == STARTUP_INTERACTIVE) {
+    APP_LOG(APP_LOG_LEVEL_INFO, "Startup (ms): init %d, first frame %d, interactive %d, heap used %d",
+            (int)s_marks[STARTUP_INIT], (int)s_marks[STARTUP_FIRST_FRAME], (int)s_marks[STARTUP_INTERACTIVE],
+            (int)heap_bytes_used());
+  }
+}
+
+#endif
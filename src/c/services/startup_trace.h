@@ -0,0 +1,26 @@
+#pragma once
+#include <pebble.h>
+
+// Opt-in cold start trace, build with -DSTARTUP_TRACE=1. Times the launch
+// from the start of init to the end of init, to the first frame of the main
+// window and to the end of the work deferred after it (interactive), and
+// logs them with the heap in use once interactive.
+#ifndef STARTUP_TRACE
+#define STARTUP_TRACE 0
+#endif
+
+typedef enum Startup_mark {
+  STARTUP_INIT, STARTUP_FIRST_FRAME, STARTUP_INTERACTIVE, STARTUP_MARK_COUNT
+} startup_mark_t;
+
+#if STARTUP_TRACE
+
+void startup_trace_begin();
+void startup_trace_mark(startup_mark_t mark);
+
+#else
+
+static inline void startup_trace_begin() {}
+static inline void startup_trace_mark(startup_mark_t mark) {}
+
+#endif
@@ -0,0 +1,149 @@
+#include <pebble.h>
+#include "sun.h"
+#include "airport.h"
+
+// Civil twilight from the usual sunrise equation, in integer arithmetic:
+// angles in micro-degrees or trig lookup units, ratios scaled by
+// TRIG_MAX_RATIO. Good to about a minute, which is what the logbook needs.
+// Results are cached per airport and UTC day.
+
+#define J2000_NOON 946728000 // 2000-01-01 12:00 UTC
+#define MICRO_DEGREES_PER_TURN 360000000LL
+#define SIN_CIVIL_TWILIGHT -6850 // sin(-6 degrees) * TRIG_MAX_RATIO
+#define SIN_OBLIQUITY 26069 // sin(23.44 degrees) * TRIG_MAX_RATIO
+#define SUN_CACHE_SIZE 4
+
+typedef struct Sun_cache_entry {
+  char icao[4];
+  time_t day;
+  sun_day_t kind;
+  time_t dawn;
+  time_t dusk;
+} sun_cache_entry_t;
+
+static sun_cache_entry_t s_cache[SUN_CACHE_SIZE];
+static uint8_t s_cache_next = 0;
+
+static int32_t to_trig_angle(int64_t micro_degrees) {
+  micro_degrees %= MICRO_DEGREES_PER_TURN;
+  if (micro_degrees < 0) {
+    micro_degrees += MICRO_DEGREES_PER_TURN;
+  }
+  return micro_degrees * TRIG_MAX_ANGLE / MICRO_DEGREES_PER_TURN;
+}
+
+static int32_t sin_udeg(int64_t micro_degrees) {
+  return sin_lookup(to_trig_angle(micro_degrees));
+}
+
+static uint32_t isqrt(uint32_t value) {
+  uint32_t root = 0;
+  uint32_t bit = 1UL << 30;
+  while (bit > value) {
+    bit >>= 2;
+  }
+  while (bit != 0) {
+    if (value >= root + bit) {
+      value -= root + bit;
+      root = (root >> 1) + bit;
+    } else {
+      root >>= 1;
+    }
+    bit >>= 2;
+  }
+  return root;
+}
+
+// lat and lon in 1/10000 of a degree, day is the UTC midnight
+static sun_day_t compute(int32_t lat, int32_t lon, time_t day, time_t *dawn, time_t *dusk) {
+  const int64_t ratio = TRIG_MAX_RATIO;
+  int32_t days = (day + SECONDS_PER_DAY / 2 - J2000_NOON) / SECONDS_PER_DAY;
+  
+  // mean anomaly and ecliptic longitude at the approximate local noon
+  int64_t anomaly = 357529100LL + 98560028LL * days / 100 - (int64_t)lon * 27378 / 100000;
+  int64_t center = (1914800LL * sin_udeg(anomaly) + 20000LL * sin_udeg(2 * anomaly) + 300LL * sin_udeg(3 * anomaly)) / ratio;
+  int64_t longitude = anomaly + center + 180000000LL + 102937200LL;
+  
+  time_t transit = day + SECONDS_PER_DAY / 2 - (int64_t)lon * 240 / 10000
+    + (458LL * sin_udeg(anomaly) - 596LL * sin_udeg(2 * longitude)) / ratio;
+  
+  int64_t sin_declination = sin_udeg(longitude) * SIN_OBLIQUITY / ratio;
+  int64_t cos_declination = isqrt(ratio * ratio - sin_declination * sin_declination);
+  int32_t latitude = to_trig_angle((int64_t)lat * 100);
+  int64_t sin_latitude = sin_lookup(latitude);
+  int64_t cos_latitude = cos_lookup(latitude);
+  
+  int64_t denominator = cos_latitude * cos_declination;
+  if (denominator == 0) {
+    return sin_latitude * sin_declination > 0 ? SUN_ALWAYS_DAY : SUN_ALWAYS_NIGHT;
+  }
+  int64_t cos_hour_angle = (SIN_CIVIL_TWILIGHT * ratio - sin_latitude * sin_declination) * ratio / denominator;
+  if (cos_hour_angle >= ratio) {
+    return SUN_ALWAYS_NIGHT;
+  } else if (cos_hour_angle <= -ratio) {
+    return SUN_ALWAYS_DAY;
+  }
+  
+  int32_t sin_hour_angle = isqrt(ratio * ratio - cos_hour_angle * cos_hour_angle);
+  int32_t hour_angle = atan2_lookup(sin_hour_angle / 2, cos_hour_angle / 2);
+  time_t half_day = (int64_t)hour_angle * SECONDS_PER_DAY / TRIG_MAX_ANGLE;
+  
+  *dawn = transit - half_day;
+  *dusk = transit + half_day;
+  return SUN_NORMAL;
+}
+
+sun_day_t sun_get_twilight(const char *icao, time_t tick, time_t *dawn, time_t *dusk) {
+  time_t day = tick - tick % SECONDS_PER_DAY;
+  
+  for (int i = 0; i < SUN_CACHE_SIZE; i++) {
+    sun_cache_entry_t *entry = &s_cache[i];
+    if (entry->day == day && strncmp(entry->icao, icao, sizeof(entry->icao)) == 0) {
+      *dawn = entry->dawn;
+      *dusk = entry->dusk;
+      return entry->kind;
+    }
+  }
+  
+  airport_t airport;
+  if (!airport_find(icao, &airport)) {
+    return SUN_UNKNOWN;
+  }
+  
+  sun_cache_entry_t *entry = &s_cache[s_cache_next];
+  s_cache_next = (s_cache_next + 1) % SUN_CACHE_SIZE;
+  memcpy(entry->icao, airport.icao, sizeof(entry->icao));
+  entry->day = day;
+  entry->dawn = day;
+  entry->dusk = day + SECONDS_PER_DAY;
+  entry->kind = compute(airport.lat, airport.lon, day, &entry->dawn, &entry->dusk);
+  if (entry->kind == SUN_ALWAYS_NIGHT) {
+    entry->dusk = entry->dawn;
+  }
+  
+  *dawn = entry->dawn;
+  *dusk = entry->dusk;
+  return entry->kind;
+}
+
+// Night part of [start, end]. Daylight runs from dawn at the departure to
+// dusk at the destination, taken for each UTC day the interval touches
+// (starting the day before, whose dusk can fall after midnight UTC).
+time_t sun_night_time(const char *departure, const char *destination, time_t start, time_t end) {
+  time_t daylight = 0;
+  
+  for (time_t day = start - start % SECONDS_PER_DAY - SECONDS_PER_DAY; day < end; day += SECONDS_PER_DAY) {
+    time_t dawn, dusk, unused;
+    if (sun_get_twilight(departure, day, &dawn, &unused) == SUN_UNKNOWN
+        || sun_get_twilight(destination, day, &unused, &dusk) == SUN_UNKNOWN) {
+      return -1;
+    }
+    
+    time_t from = dawn > start ? dawn : start;
+    time_t to = dusk < end ? dusk : end;
+    if (to > from) {
+      daylight += to - from;
+    }
+  }
+  return end - start - daylight;
+}
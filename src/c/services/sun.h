@@ -0,0 +1,9 @@
+#pragma once
+#include <pebble.h>
+
+typedef enum Sun_day {
+  SUN_NORMAL, SUN_ALWAYS_DAY, SUN_ALWAYS_NIGHT, SUN_UNKNOWN
+} sun_day_t;
+
+sun_day_t sun_get_twilight(const char *icao, time_t tick, time_t *dawn, time_t *dusk);
+time_t sun_night_time(const char *departure, const char *destination, time_t start, time_t end);
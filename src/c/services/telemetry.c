@@ -0,0 +1,75 @@
+#include <pebble.h>
+#include "telemetry.h"
+
+// Events are staged in RAM and handed to the DataLogging session in
+// batches, the firmware then delivers them to the phone whenever it is
+// connected. When the session cannot keep up, new events are dropped
+// rather than growing the buffer.
+
+#define TELEMETRY_TAG 0x464C0001
+#define TELEMETRY_STAGING_SIZE 16
+#define TELEMETRY_FLUSH_DELAY_MS (60 * 1000)
+
+static DataLoggingSessionRef s_session;
+static telemetry_record_t s_staging[TELEMETRY_STAGING_SIZE];
+static uint8_t s_staged = 0;
+static uint16_t s_dropped = 0;
+static AppTimer *s_flush_timer = NULL;
+
+static void flush() {
+  if (s_staged == 0 || s_session == NULL) {
+    return;
+  }
+  
+  DataLoggingResult result = data_logging_log(s_session, s_staging, s_staged);
+  if (result == DATA_LOGGING_SUCCESS) {
+    s_staged = 0;
+  } else {
+    APP_LOG(APP_LOG_LEVEL_WARNING, "Telemetry flush failed: %d", (int)result);
+  }
+}
+
+static void flush_callback(void *data) {
+  s_flush_timer = NULL;
+  flush();
+}
+
+void telemetry_init() {
+  s_session = data_logging_create(TELEMETRY_TAG, DATA_LOGGING_BYTE_ARRAY, sizeof(telemetry_record_t), true);
+}
+
+void telemetry_deinit() {
+  if (s_flush_timer != NULL) {
+    app_timer_cancel(s_flush_timer);
+    s_flush_timer = NULL;
+  }
+  flush();
+  if (s_dropped > 0) {
+    APP_LOG(APP_LOG_LEVEL_WARNING, "Telemetry dropped %d events", s_dropped);
+  }
+  data_logging_finish(s_session);
+  s_session = NULL;
+}
+
+void telemetry_log(telemetry_event_t event, uint8_t arg) {
+  if (s_staged == TELEMETRY_STAGING_SIZE) {
+    flush();
+    if (s_staged == TELEMETRY_STAGING_SIZE) {
+      s_dropped++;
+      return;
+    }
+  }
+  
+  telemetry_record_t *record = &s_staging[s_staged++];
+  time_t seconds;
+  record->ms = time_ms(&seconds, NULL);
+  record->timestamp = seconds;
+  record->event = event;
+  record->arg = arg;
+  
+  if (s_staged == TELEMETRY_STAGING_SIZE) {
+    flush();
+  } else if (s_flush_timer == NULL) {
+    s_flush_timer = app_timer_register(TELEMETRY_FLUSH_DELAY_MS, flush_callback, NULL);
+  }
+}
@@ -0,0 +1,18 @@
+#pragma once
+#include <pebble.h>
+
+typedef enum Telemetry_event {
+  EVENT_PHASE_NEXT, EVENT_PHASE_CANCEL, EVENT_ALARM_FIRE, EVENT_ALARM_ACK, EVENT_ET_FLYBACK, EVENT_WAYPOINT, EVENT_TOUCH_AND_GO
+} telemetry_event_t;
+
+// Fixed-size record logged for each event, decoded by tools/telemetry_decode.py
+typedef struct __attribute__((__packed__)) Telemetry_record {
+  uint32_t timestamp;
+  uint16_t ms;
+  uint8_t event;
+  uint8_t arg; // phase, alarm type, waypoint number or landing count, 0 otherwise
+} telemetry_record_t;
+
+void telemetry_init();
+void telemetry_deinit();
+void telemetry_log(telemetry_event_t event, uint8_t arg);
@@ -14,6 +14,12 @@ TextLayer *configure_text_layer(Layer *window_layer, GRect box, GFont font, GTex
   return layer;
 }
 
+Layer *configure_digit_layer(Layer *window_layer, GRect box, GFont font, GTextAlignment alignment) {
+  Layer *layer = digit_layer_create(box, font, alignment);
+  layer_add_child(window_layer, layer);
+  return layer;
+}
+
 void format_duration_hhmm(time_t time_in_s, char *buffer, int size) {
   int minutes = (int)time_in_s / 60 % 60;
   int hours = (int)time_in_s / 3600 % 1000;
@@ -26,7 +32,43 @@ void format_duration_hhmm(time_t time_in_s, char *buffer, int size) {
   snprintf(buffer, size, "%d:%02d", hours, minutes);
 }
 
+void format_duration_mmss(time_t time_in_s, char *buffer, int size) {
+  int seconds = (int)time_in_s % 60;
+  int minutes = (int)time_in_s / 60;
+  
+  if (minutes > 99) {
+    minutes = 99;
+    seconds = 59;
+  }
+  
+  snprintf(buffer, size, "%d:%02d", minutes, seconds);
+}
+
 void format_time_hhmm(time_t time_in_s, char *buffer, int size) {
   struct tm *tick_time_z = gmtime(&time_in_s);
   strftime(buffer, size, "%H:%M", tick_time_z);
-}
\ No newline at end of file
+}
+
+time_t time_rounded() {
+  time_t now;
+  uint16_t now_ms;
+  time_ms(&now, &now_ms);
+  return now + (now_ms >= 500 ? 1 : 0);
+}
+
+uint16_t read_uint16(const uint8_t *data) {
+  return data[0] | data[1] << 8;
+}
+
+uint32_t read_uint32(const uint8_t *data) {
+  return read_uint16(data) | (uint32_t)read_uint16(data + 2) << 16;
+}
+
+uint16_t fletcher16(const uint8_t *data, uint16_t length) {
+  uint16_t sum1 = 0, sum2 = 0;
+  for (uint16_t i = 0; i < length; i++) {
+    sum1 = (sum1 + data[i]) % 255;
+    sum2 = (sum2 + sum1) % 255;
+  }
+  return sum2 << 8 | sum1;
+}
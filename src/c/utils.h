@@ -1,6 +1,17 @@
 #pragma once
 #include <pebble.h>
+#include "layers/digit_layer.h"
 
 TextLayer *configure_text_layer(Layer *window_layer, GRect box, GFont font, GTextAlignment alignment);
+Layer *configure_digit_layer(Layer *window_layer, GRect box, GFont font, GTextAlignment alignment);
 void format_duration_hhmm(time_t time_in_s, char buffer[], int size);
-void format_time_hhmm(time_t time_in_s, char buffer[], int size);
\ No newline at end of file
+void format_duration_mmss(time_t time_in_s, char buffer[], int size);
+void format_time_hhmm(time_t time_in_s, char buffer[], int size);
+// Current time to the nearest second, time() truncates
+time_t time_rounded();
+
+// The messages from the phone are little-endian byte arrays closed by a
+// Fletcher-16 checksum of everything before it
+uint16_t read_uint16(const uint8_t *data);
+uint32_t read_uint32(const uint8_t *data);
+uint16_t fletcher16(const uint8_t *data, uint16_t length);
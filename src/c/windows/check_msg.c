@@ -1,5 +1,10 @@
 #include <pebble.h>
 #include "check_msg.h"
+#include "../layout.h"
+#include "../services/telemetry.h"
+#include "../services/battery_monitor.h"
+#include "../services/power.h"
+#include "../services/settings.h"
 #define ALARM_TYPE_COUNT 2
 
 typedef struct Alarm {
@@ -7,8 +12,8 @@ typedef struct Alarm {
   bool active;
   bool important;
   char text[45];
-  time_t delay;
-  time_t hide_delay;
+  setting_id_t delay;
+  setting_id_t hide_delay;
   AppTimer *timer;
 } alarm_t;
 
@@ -17,8 +22,8 @@ static alarm_t s_cruise_check = {
   .active = false,
   .important = false,
   .text = "Cruise check reminder",
-  .delay = 15 * SECONDS_PER_MINUTE * 1000,
-  .hide_delay = 2 * SECONDS_PER_MINUTE *1000,
+  .delay = SETTING_CRUISE_CHECK_INTERVAL,
+  .hide_delay = SETTING_CRUISE_CHECK_DISPLAY,
   .timer = NULL
   };
 
@@ -27,8 +32,8 @@ static alarm_t s_endurance_alarm = {
   .active = false,
   .important = true,
   .text = "Fuel reserve low",
-  .delay = 15 * SECONDS_PER_MINUTE * 1000,
-  .hide_delay = 15 * SECONDS_PER_MINUTE *1000,
+  .delay = SETTING_RESERVE_ALARM_INTERVAL,
+  .hide_delay = SETTING_RESERVE_ALARM_DISPLAY,
   .timer = NULL
   };
 
@@ -37,11 +42,20 @@ static alarm_t s_flight_plan = {
   .active = false,
   .important = false,
   .text = "Have you closed your flight plan ?",
-  .delay = 5 * SECONDS_PER_MINUTE * 1000,
-  .hide_delay = 10 * SECONDS_PER_MINUTE * 1000,
+  .delay = SETTING_FLIGHT_PLAN_DELAY,
+  .hide_delay = SETTING_FLIGHT_PLAN_DISPLAY,
   .timer = NULL};
 
-static alarm_t *s_alarm_defs[] = {&s_cruise_check, &s_endurance_alarm, &s_flight_plan};
+static alarm_t s_battery_alarm = {
+  .inhibited = false,
+  .active = false,
+  .important = false,
+  .text = "Watch battery may not last the flight",
+  .delay = SETTING_BATTERY_ALARM_INTERVAL,
+  .hide_delay = SETTING_BATTERY_ALARM_DISPLAY,
+  .timer = NULL};
+
+static alarm_t *s_alarm_defs[] = {&s_cruise_check, &s_endurance_alarm, &s_flight_plan, &s_battery_alarm};
 
 static Window *s_main_window;
 static TextLayer *s_label_layer;
@@ -53,7 +67,16 @@ static GBitmap *s_icon_bitmap, *s_tick_bitmap, *s_danger_bitmap;
 static AppTimer *s_display_timer;
 static alarm_t *s_last_alarm;
 
+static uint8_t alarm_index(alarm_t *alarm) {
+  uint8_t index = 0;
+  while (index < ARRAY_LENGTH(s_alarm_defs) && s_alarm_defs[index] != alarm) {
+    index++;
+  }
+  return index;
+}
+
 void click_handler(ClickRecognizerRef recognizer, void *context) {
+  telemetry_log(EVENT_ALARM_ACK, alarm_index(s_last_alarm));
   window_stack_pop(true);
 }
 
@@ -62,21 +85,47 @@ void click_config_provider(void *context) {
 }
 
 
-static void window_load(Window *window) {
-  Layer *window_layer = window_get_root_layer(window);
+static void window_expired(void *data) {
+  window_stack_pop(true);
+}
+
+static void window_appear(Window *window) {
+  battery_monitor_set_mode(BATTERY_MODE_ALARM, true);
+  s_display_timer = app_timer_register(settings_get_ms(s_last_alarm->hide_delay), window_expired, NULL);
+  text_layer_set_text(s_label_layer, s_last_alarm->text);
+  bitmap_layer_set_bitmap(s_icon_layer, s_last_alarm->important ? s_danger_bitmap : s_icon_bitmap);
+  window_set_background_color(s_main_window, PBL_IF_COLOR_ELSE(s_last_alarm->important ? GColorYellow : GColorJaegerGreen, GColorWhite));
+}
+
+static void window_disappear(Window *window) {
+  battery_monitor_set_mode(BATTERY_MODE_ALARM, false);
+  if (s_display_timer != NULL) {
+    app_timer_cancel(s_display_timer);
+    s_display_timer = NULL;
+  } 
+}
+
+// Built at startup, then kept until exit
+static void create() {
+  s_main_window = window_create();
+  window_set_background_color(s_main_window, PBL_IF_COLOR_ELSE(GColorJaegerGreen, GColorWhite));
+  window_set_window_handlers(s_main_window, (WindowHandlers) {
+    .appear = window_appear,
+    .disappear = window_disappear,
+  });
+  
+  Layer *window_layer = window_get_root_layer(s_main_window);
   GRect bounds = layer_get_bounds(window_layer);
 
   s_icon_bitmap = gbitmap_create_with_resource(RESOURCE_ID_CONFIRM);
   s_danger_bitmap = gbitmap_create_with_resource(RESOURCE_ID_DANGER);
 
-  const GEdgeInsets icon_insets = {.top = 1, .right = 28, .bottom = 66, .left = 14};
-  s_icon_layer = bitmap_layer_create(grect_inset(bounds, icon_insets));
+  s_icon_layer = bitmap_layer_create(grect_inset(bounds, LAYOUT_ALARM_ICON_INSETS));
   bitmap_layer_set_bitmap(s_icon_layer, s_icon_bitmap);
   bitmap_layer_set_compositing_mode(s_icon_layer, GCompOpSet);
   layer_add_child(window_layer, bitmap_layer_get_layer(s_icon_layer));
 
-  const GEdgeInsets label_insets = {.top = 90, .right = ACTION_BAR_WIDTH , .left = ACTION_BAR_WIDTH / 2};
-  s_label_layer = text_layer_create(grect_inset(bounds, label_insets));
+  s_label_layer = text_layer_create(grect_inset(bounds, LAYOUT_ALARM_LABEL_INSETS));
   text_layer_set_background_color(s_label_layer, GColorClear);
   text_layer_set_text_alignment(s_label_layer, GTextAlignmentCenter);
   text_layer_set_font(s_label_layer, fonts_get_system_font(FONT_KEY_GOTHIC_24_BOLD));
@@ -86,11 +135,14 @@ static void window_load(Window *window) {
 
   s_action_bar_layer = action_bar_layer_create();
   action_bar_layer_set_icon(s_action_bar_layer, BUTTON_ID_SELECT, s_tick_bitmap);
-  action_bar_layer_add_to_window(s_action_bar_layer, window);
+  action_bar_layer_add_to_window(s_action_bar_layer, s_main_window);
   action_bar_layer_set_click_config_provider(s_action_bar_layer, click_config_provider);
 }
 
-static void window_unload(Window *window) {
+void check_msg_deinit() {
+  if (s_main_window == NULL) {
+    return;
+  }
   text_layer_destroy(s_label_layer);
   action_bar_layer_destroy(s_action_bar_layer);
   bitmap_layer_destroy(s_icon_layer);
@@ -99,39 +151,18 @@ static void window_unload(Window *window) {
   gbitmap_destroy(s_tick_bitmap);
   gbitmap_destroy(s_danger_bitmap);
 
-  window_destroy(window);
+  window_destroy(s_main_window);
   s_main_window = NULL;
 }
 
-static void window_expired(void *data) {
-  window_stack_pop(true);
-}
-
-static void window_appear(Window *window) {
-  s_display_timer = app_timer_register(s_last_alarm->hide_delay, window_expired, NULL);
-  text_layer_set_text(s_label_layer, s_last_alarm->text);
-  bitmap_layer_set_bitmap(s_icon_layer, s_last_alarm->important ? s_danger_bitmap : s_icon_bitmap);
-  window_set_background_color(s_main_window, PBL_IF_COLOR_ELSE(s_last_alarm->important ? GColorYellow : GColorJaegerGreen, GColorWhite));
-}
-
-static void window_disappear(Window *window) {
-  if (s_display_timer != NULL) {
-    app_timer_cancel(s_display_timer);
-    s_display_timer = NULL;
-  } 
+void check_msg_init() {
+  if (s_main_window == NULL) {
+    create();
+  }
 }
 
 static void dialog_choice_window_push() {
-  if(!s_main_window) {
-    s_main_window = window_create();
-    window_set_background_color(s_main_window, PBL_IF_COLOR_ELSE(GColorJaegerGreen, GColorWhite));
-    window_set_window_handlers(s_main_window, (WindowHandlers) {
-      .load = window_load,
-      .unload = window_unload,
-      .appear = window_appear,
-      .disappear = window_disappear,
-    });
-  }
+  check_msg_init();
   window_stack_push(s_main_window, true);
 }
 
@@ -143,13 +174,15 @@ static void alarm_callback(void* data) {
     bitmap_layer_set_bitmap(s_icon_layer, s_last_alarm->important ? s_danger_bitmap : s_icon_bitmap);
     window_set_background_color(s_main_window, PBL_IF_COLOR_ELSE(alarm->important ? GColorYellow : GColorJaegerGreen, GColorWhite));
     if (alarm->timer != NULL) {
-      app_timer_reschedule(s_display_timer, s_last_alarm->hide_delay);
+      app_timer_reschedule(s_display_timer, settings_get_ms(s_last_alarm->hide_delay));
     }
   } else {
     dialog_choice_window_push();
   }
-  alarm->important ? vibes_long_pulse() : vibes_double_pulse();
-  alarm->timer = app_timer_register(alarm->delay, alarm_callback, alarm);
+  power_vibe(alarm->important ? VIBE_WARNING : VIBE_ALARM);
+  power_light();
+  telemetry_log(EVENT_ALARM_FIRE, alarm_index(alarm));
+  alarm->timer = app_timer_register(settings_get_ms(alarm->delay), alarm_callback, alarm);
 }
 
 static void alarm_do_start(alarm_t *alarm, bool now) {
@@ -157,7 +190,7 @@ static void alarm_do_start(alarm_t *alarm, bool now) {
     app_timer_cancel(alarm->timer);
     alarm->timer = NULL;
   }
-  alarm->timer = app_timer_register(now ? 0 : alarm->delay, alarm_callback, alarm);
+  alarm->timer = app_timer_register(now ? 0 : settings_get_ms(alarm->delay), alarm_callback, alarm);
 }
 
 static void alarm_start_impl(alarm_type type, bool now) {
@@ -3,9 +3,14 @@
 #define DIALOG_MESSAGE_WINDOW_MARGIN   10
 
 typedef enum Alarm_type {
-  ALARM_CRUISE_CHECK, ALARM_ENDURANCE, ALARM_FLIGHT_PLAN
+  ALARM_CRUISE_CHECK, ALARM_ENDURANCE, ALARM_FLIGHT_PLAN, ALARM_BATTERY
 } alarm_type ;
 
+// The alarm window and its layers are created by check_msg_init, before the
+// first off-block, and kept: nothing is allocated in flight
+void check_msg_init();
+void check_msg_deinit();
+
 void alarm_start(alarm_type type);
 void alarm_display(alarm_type type);
 void alarm_stop(alarm_type type);
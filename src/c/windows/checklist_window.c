@@ -0,0 +1,145 @@
+#include <pebble.h>
+#include "checklist_window.h"
+#include "../services/power.h"
+
+static Window *s_main_window;
+static MenuLayer *s_menu_layer;
+static GBitmap *s_tick_bitmap;
+
+static checklist_id_t s_list;
+static uint16_t s_item_count;
+static uint8_t s_checked[CHECKLIST_MAX_ITEMS / 8];
+
+static bool is_checked(uint16_t item) {
+  return s_checked[item / 8] & (1 << item % 8);
+}
+
+static bool all_checked() {
+  for (uint16_t i = 0; i < s_item_count; i++) {
+    if (!is_checked(i)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static void open_list(checklist_id_t list) {
+  s_list = list;
+  s_item_count = checklist_get_item_count(list);
+  memset(s_checked, 0, sizeof(s_checked));
+}
+
+static uint16_t get_num_rows_callback(MenuLayer *menu_layer, 
+                                      uint16_t section_index, void *context) {
+  return s_item_count;
+}
+
+static int16_t get_header_height_callback(MenuLayer *menu_layer, uint16_t section_index, void *context) {
+  return MENU_CELL_BASIC_HEADER_HEIGHT;
+}
+
+static void draw_header_callback(GContext *ctx, const Layer *cell_layer, uint16_t section_index, void *context) {
+  menu_cell_basic_header_draw(ctx, cell_layer, checklist_get_title(s_list));
+}
+
+static void draw_row_callback(GContext *ctx, const Layer *cell_layer, 
+                                        MenuIndex *cell_index, void *context) {
+  GRect bounds = layer_get_bounds(cell_layer);
+  GRect box = GRect(4, (bounds.size.h - 18) / 2, 18, 18);
+  
+  if (is_checked(cell_index->row)) {
+    graphics_context_set_compositing_mode(ctx, GCompOpSet);
+    graphics_draw_bitmap_in_rect(ctx, s_tick_bitmap, box);
+  } else {
+    graphics_draw_rect(ctx, box);
+  }
+  
+  graphics_draw_text(ctx, checklist_get_item(s_list, cell_index->row), fonts_get_system_font(FONT_KEY_GOTHIC_18_BOLD),
+                     GRect(28, 0, bounds.size.w - 30, bounds.size.h), GTextOverflowModeTrailingEllipsis, GTextAlignmentLeft, NULL);
+}
+
+static int16_t get_cell_height_callback(struct MenuLayer *menu_layer, 
+                                        MenuIndex *cell_index, void *context) {
+  const int16_t cell_height = 44;
+  return cell_height;
+}
+
+static void select_callback(struct MenuLayer *menu_layer, 
+                                        MenuIndex *cell_index, void *context) {
+  s_checked[cell_index->row / 8] ^= 1 << cell_index->row % 8;
+  
+  if (all_checked()) {
+    power_vibe(VIBE_NOTICE);
+    window_stack_remove(s_main_window, true);
+    return;
+  }
+  menu_layer_set_selected_next(menu_layer, false, MenuRowAlignCenter, true);
+  layer_mark_dirty(menu_layer_get_layer(menu_layer));
+}
+
+// Long select moves on to the next list, e.g. from cruise to landing
+static void select_long_callback(struct MenuLayer *menu_layer, 
+                                        MenuIndex *cell_index, void *context) {
+  open_list((s_list + 1) % checklist_get_list_count());
+  menu_layer_reload_data(menu_layer);
+  menu_layer_set_selected_index(menu_layer, (MenuIndex) { .section = 0, .row = 0 }, MenuRowAlignTop, false);
+}
+
+static void create() {
+  s_main_window = window_create();
+  
+  Layer *window_layer = window_get_root_layer(s_main_window);
+  GRect bounds = layer_get_bounds(window_layer);
+  
+  s_tick_bitmap = gbitmap_create_with_resource(RESOURCE_ID_TICK);
+
+  s_menu_layer = menu_layer_create(bounds);
+  menu_layer_set_click_config_onto_window(s_menu_layer, s_main_window);
+#if defined(PBL_COLOR)
+  menu_layer_set_normal_colors(s_menu_layer, GColorBlack, GColorWhite);
+  menu_layer_set_highlight_colors(s_menu_layer, GColorRed, GColorWhite);
+#endif
+  
+  menu_layer_set_callbacks(s_menu_layer, NULL, (MenuLayerCallbacks) {
+    .get_num_rows = get_num_rows_callback,
+    .get_header_height = get_header_height_callback,
+    .draw_header = draw_header_callback,
+    .draw_row = draw_row_callback,
+    .get_cell_height = get_cell_height_callback,
+    .select_click = select_callback,
+    .select_long_click = select_long_callback,
+  });
+  
+  layer_add_child(window_layer, menu_layer_get_layer(s_menu_layer));
+}
+
+void checklist_window_deinit() {
+  if (s_main_window == NULL) {
+    return;
+  }
+  menu_layer_destroy(s_menu_layer);
+  gbitmap_destroy(s_tick_bitmap);
+  
+  window_destroy(s_main_window);
+  s_main_window = NULL;
+}
+
+void checklist_window_init() {
+  if (s_main_window == NULL) {
+    create();
+  }
+}
+
+void checklist_window_push(checklist_id_t list) {
+  if (list >= checklist_get_list_count()) {
+    return;
+  }
+  checklist_window_init();
+  open_list(list);
+  
+  menu_layer_reload_data(s_menu_layer);
+  menu_layer_set_selected_index(s_menu_layer, (MenuIndex) { .section = 0, .row = 0 }, MenuRowAlignTop, false);
+  if (!window_stack_contains_window(s_main_window)) {
+    window_stack_push(s_main_window, true);
+  }
+}
@@ -0,0 +1,8 @@
+#pragma once
+#include "../services/checklist.h"
+
+// The checklist window and its layers are created by checklist_window_init
+// and kept
+void checklist_window_init();
+void checklist_window_deinit();
+void checklist_window_push(checklist_id_t list);
@@ -0,0 +1,112 @@
+#include <pebble.h>
+#include "debug_window.h"
+#include "../services/heap_guard.h"
+#include "../services/battery_monitor.h"
+
+#if PROFILE
+
+#define DEBUG_REFRESH_MS 1000
+
+static Window *s_main_window;
+static MenuLayer *s_menu_layer;
+static AppTimer *s_refresh_timer;
+
+// The heap and the battery first, then one row per probe
+#define DEBUG_FIXED_ROWS 2
+
+static uint16_t get_num_rows_callback(MenuLayer *menu_layer, 
+                                      uint16_t section_index, void *context) {
+  return DEBUG_FIXED_ROWS + PROFILE_COUNT;
+}
+
+static void draw_row_callback(GContext *ctx, const Layer *cell_layer, 
+                                        MenuIndex *cell_index, void *context) {
+  static char s_buffer[48]; // fits the five numbers of a probe row
+  
+  if (cell_index->row == 0) {
+    snprintf(s_buffer, sizeof(s_buffer), "%d free %d used, %d", (int)heap_bytes_free(), (int)heap_bytes_used(),
+             heap_guard_violations());
+    menu_cell_basic_draw(ctx, cell_layer, "Heap", s_buffer, NULL);
+    return;
+  }
+  if (cell_index->row == 1) {
+    int rate = battery_monitor_get_rate(BATTERY_MODE_TICKING);
+    snprintf(s_buffer, sizeof(s_buffer), "%d.%02d%%/h, %dh%02d left", rate / 100, rate % 100,
+             (int)(battery_monitor_get_remaining() / SECONDS_PER_HOUR), (int)(battery_monitor_get_remaining() / SECONDS_PER_MINUTE % 60));
+    menu_cell_basic_draw(ctx, cell_layer, "Battery", s_buffer, NULL);
+    return;
+  }
+  
+  profile_probe_t probe = cell_index->row - DEBUG_FIXED_ROWS;
+  const profile_stats_t *stats = profile_get(probe);
+  if (stats->count == 0) {
+    strcpy(s_buffer, "Not called");
+  } else {
+    int avg_x10 = stats->total_ms * 10 / stats->count;
+    snprintf(s_buffer, sizeof(s_buffer), "%lu x %d/%d.%d/%d ms", (unsigned long)stats->count,
+             stats->min_ms, avg_x10 / 10, avg_x10 % 10, stats->max_ms);
+  }
+  menu_cell_basic_draw(ctx, cell_layer, profile_get_name(probe), s_buffer, NULL);
+}
+
+// Select clears the counters
+static void select_callback(struct MenuLayer *menu_layer, 
+                                        MenuIndex *cell_index, void *context) {
+  profile_reset();
+  menu_layer_reload_data(menu_layer);
+}
+
+static void refresh_callback(void *data) {
+  menu_layer_reload_data(s_menu_layer);
+  s_refresh_timer = app_timer_register(DEBUG_REFRESH_MS, refresh_callback, NULL);
+}
+
+static void window_appear(Window *window) {
+  refresh_callback(NULL);
+}
+
+static void window_disappear(Window *window) {
+  app_timer_cancel(s_refresh_timer);
+  s_refresh_timer = NULL;
+}
+
+static void create() {
+  s_main_window = window_create();
+  
+  Layer *window_layer = window_get_root_layer(s_main_window);
+  s_menu_layer = menu_layer_create(layer_get_bounds(window_layer));
+  menu_layer_set_click_config_onto_window(s_menu_layer, s_main_window);
+  menu_layer_set_callbacks(s_menu_layer, NULL, (MenuLayerCallbacks) {
+    .get_num_rows = get_num_rows_callback,
+    .draw_row = draw_row_callback,
+    .select_click = select_callback,
+  });
+  layer_add_child(window_layer, menu_layer_get_layer(s_menu_layer));
+  
+  window_set_window_handlers(s_main_window, (WindowHandlers) {
+    .appear = window_appear,
+    .disappear = window_disappear
+  });
+}
+
+void debug_window_deinit() {
+  if (s_main_window == NULL) {
+    return;
+  }
+  menu_layer_destroy(s_menu_layer);
+  window_destroy(s_main_window);
+  s_main_window = NULL;
+}
+
+void debug_window_init() {
+  if (s_main_window == NULL) {
+    create();
+  }
+}
+
+void debug_window_push() {
+  debug_window_init();
+  window_stack_push(s_main_window, true);
+}
+
+#endif
@@ -0,0 +1,19 @@
+#pragma once
+#include <pebble.h>
+#include "../services/profile.h"
+
+// Live profile counters and heap usage, only in PROFILE builds. Opened by a
+// long press on Select on the Exit row of the flight menu.
+#if PROFILE
+
+void debug_window_init();
+void debug_window_deinit();
+void debug_window_push();
+
+#else
+
+static inline void debug_window_init() {}
+static inline void debug_window_deinit() {}
+static inline void debug_window_push() {}
+
+#endif
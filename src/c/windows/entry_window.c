@@ -0,0 +1,99 @@
+#include <pebble.h>
+#include "entry_window.h"
+#include "../layout.h"
+
+static Window *s_window;
+static TextLayer *s_main_text, *s_sub_text;
+static Layer *s_entry;
+static StatusBarLayer *s_status;
+
+static const EntryDefinition *s_definition;
+
+static void entry_complete(Layer *layer, void *context) {
+  int16_t values[ENTRY_WINDOW_MAX_FIELDS];
+  for (int i = 0; i < s_definition->field_count && i < ENTRY_WINDOW_MAX_FIELDS; i++) {
+    values[i] = entry_layer_get_value(layer, i);
+  }
+  window_stack_remove(s_window, true);
+  s_definition->complete(values);
+}
+
+static void create() {
+  s_window = window_create();
+  
+  // Get window parameters
+  Layer *window_layer = window_get_root_layer(s_window);
+  GRect bounds = layer_get_bounds(window_layer);
+  
+  // Main TextLayer
+  s_main_text = text_layer_create(grect_inset(bounds, LAYOUT_ENTRY_MAIN_INSETS));
+  text_layer_set_font(s_main_text, fonts_get_system_font(FONT_KEY_GOTHIC_18_BOLD));
+  text_layer_set_text_alignment(s_main_text, GTextAlignmentCenter);
+  layer_add_child(window_layer, text_layer_get_layer(s_main_text));
+  
+  // Sub TextLayer
+  s_sub_text = text_layer_create(grect_inset(bounds, LAYOUT_ENTRY_SUB_INSETS));
+  text_layer_set_text_alignment(s_sub_text, GTextAlignmentCenter);
+  text_layer_set_font(s_sub_text, fonts_get_system_font(FONT_KEY_GOTHIC_18_BOLD));
+  layer_add_child(window_layer, text_layer_get_layer(s_sub_text));
+  
+  // Entry layer, sized for each entry when pushed
+  s_entry = entry_layer_create(GRect(0, (bounds.size.h - ENTRY_WINDOW_HEIGHT) / 2, bounds.size.w, ENTRY_WINDOW_HEIGHT), ENTRY_WINDOW_MAX_FIELDS);
+  entry_layer_set_cell_padding(s_entry, 4);
+  entry_layer_set_active_bg_color(s_entry, GColorRed);
+  entry_layer_set_inactive_bg_color(s_entry, GColorDarkGray);
+  entry_layer_set_click_config_onto_window(s_entry, s_window);
+  entry_layer_set_callbacks(s_entry, NULL, (EntryLayerCallbacks) {
+    .complete = entry_complete,
+  });
+  layer_add_child(window_layer, s_entry);
+  
+  // Create status bar
+  s_status = status_bar_layer_create();
+  status_bar_layer_set_colors(s_status, GColorClear, GColorBlack);
+  layer_add_child(window_layer, status_bar_layer_get_layer(s_status));
+}
+
+void entry_window_deinit() {
+  if (s_window == NULL) {
+    return;
+  }
+  status_bar_layer_destroy(s_status);
+  entry_layer_destroy(s_entry);
+  text_layer_destroy(s_sub_text);
+  text_layer_destroy(s_main_text);
+  window_destroy(s_window);
+  s_window = NULL;
+}
+
+void entry_window_init() {
+  if (s_window == NULL) {
+    create();
+  }
+}
+
+void entry_window_push(const EntryDefinition *definition, const int16_t values[]) {
+  entry_window_init();
+  s_definition = definition;
+  text_layer_set_text(s_main_text, definition->main_text);
+  text_layer_set_text(s_sub_text, definition->sub_text);
+  
+  // Centered on the cells of this entry
+  EntryLayerData *data = layer_get_data(s_entry);
+  int width = 0;
+  for (int i = 0; i < definition->field_count; i++) {
+    width += definition->fields[i].width + (i > 0 ? data->cell_padding : 0);
+  }
+  GRect bounds = layer_get_bounds(window_get_root_layer(s_window));
+  GRect frame = layer_get_frame(s_entry);
+  frame.origin.x = (bounds.size.w - width) / 2;
+  frame.size.w = width;
+  layer_set_frame(s_entry, frame);
+  
+  entry_layer_set_fields(s_entry, definition->fields, definition->field_count, values);
+  window_stack_push(s_window, true);
+}
+
+void entry_window_set_highlight_color(GColor color) {
+  entry_layer_set_active_bg_color(s_entry, color);
+}
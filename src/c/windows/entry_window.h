@@ -0,0 +1,42 @@
+#pragma once
+
+#include <pebble.h>
+#include "../layers/entry_layer.h"
+
+#define ENTRY_WINDOW_MAX_FIELDS 4
+#define ENTRY_WINDOW_HEIGHT 34
+
+typedef void (*EntryWindowComplete)(const int16_t values[]);
+
+typedef struct EntryDefinition {
+  const char *main_text;
+  const char *sub_text;
+  const EntryField *fields;
+  uint8_t field_count;
+  EntryWindowComplete complete;
+} EntryDefinition;
+
+/*
+ * Creates the entry window, from flight_menu_init so that no entry made in
+ * flight allocates it
+ */
+void entry_window_init();
+
+/*
+ * Destroys the entry window, if it was ever created. The same window is used
+ * for every kind of entry: hh:mm, fuel quantity, burn rate...
+ */
+void entry_window_deinit();
+
+/*
+ * Push the window onto the stack for a new entry
+ *  definition: the fields and texts, must stay valid while the window is shown
+ *  values: the initial value of each field
+ */
+void entry_window_push(const EntryDefinition *definition, const int16_t values[]);
+
+/*
+ * Sets the over-all color scheme of the window
+ *  color: the GColor to set the highlight to
+ */
+void entry_window_set_highlight_color(GColor color);
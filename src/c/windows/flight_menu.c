@@ -2,18 +2,59 @@
 #include "flight_menu.h"
 #include "../components/mission.h"
 #include "check_msg.h"
-#include "time_window.h"
+#include "entry_window.h"
 #include "../components/endurance.h"
+#include "../services/logbook.h"
+#include "../services/export.h"
+#include "../services/flight_plan.h"
+#include "../components/navlog.h"
+#include "../components/et.h"
+#include "checklist_window.h"
+#include "debug_window.h"
+#include "../services/power.h"
+#include "settings_window.h"
+#include "timeline_window.h"
 
 static Window *s_main_window;
-static TimeWindow *s_time_window;
 static MenuLayer *s_menu_layer;
 
 static GBitmap *s_check_bitmap, *s_gas_bitmap, *s_exit_bitmap, *s_charlie_bitmap;
 
+static void endurance_complete(const int16_t values[]);
+static void fuel_complete(const int16_t values[]);
+
+static const EntryField s_endurance_fields[] = {
+  { .min = 0, .max = 99, .step = 1, .digits = 2, .width = 50 },
+  { .min = 0, .max = 59, .step = 1, .fast_step = 5, .digits = 2, .width = 50 }
+};
+
+static const EntryDefinition s_endurance_entry = {
+  .main_text = "ENDURANCE",
+  .sub_text = "Enter endurance at take-off (hh:mm)",
+  .fields = s_endurance_fields,
+  .field_count = ARRAY_LENGTH(s_endurance_fields),
+  .complete = endurance_complete
+};
+
+// Fuel on board in units, burn rate in tenths of a unit per hour
+static const EntryField s_fuel_fields[] = {
+  { .min = 0, .max = 999, .step = 1, .fast_step = 10, .digits = 1, .width = 56 },
+  { .min = 1, .max = 999, .step = 1, .fast_step = 10, .digits = 1, .decimals = 1, .width = 64 }
+};
+
+static const EntryDefinition s_fuel_entry = {
+  .main_text = "FUEL / BURN",
+  .sub_text = "Fuel on board, burn per hour",
+  .fields = s_fuel_fields,
+  .field_count = ARRAY_LENGTH(s_fuel_fields),
+  .complete = fuel_complete
+};
+
+static int16_t s_fuel_values[] = { 0, 100 };
+
 static uint16_t get_num_rows_callback(MenuLayer *menu_layer, 
                                       uint16_t section_index, void *context) {
-  const uint16_t num_rows = 4;
+  const uint16_t num_rows = 13;
   return num_rows;
 }
 
@@ -21,17 +62,58 @@ static void draw_row_callback(GContext *ctx, const Layer *cell_layer,
                                         MenuIndex *cell_index, void *context) {
   switch(cell_index->row) {
     case 0:
-      menu_cell_basic_draw(ctx, cell_layer, "Cruise check", alarm_is_inhibited(ALARM_CRUISE_CHECK) ? "Enable reminders" : "Inhibit reminders", s_check_bitmap);
+      menu_cell_basic_draw(ctx, cell_layer, "Touch-and-go", mission_is_in_flight() ? "Count a landing" : "In flight only", s_check_bitmap);
       break;
     case 1:
-      menu_cell_basic_draw(ctx, cell_layer, "Exit", "Long-press back", s_exit_bitmap);
+      menu_cell_basic_draw(ctx, cell_layer, "Cruise check", alarm_is_inhibited(ALARM_CRUISE_CHECK) ? "Enable reminders" : "Inhibit reminders", s_check_bitmap);
       break;
     case 2:
-      menu_cell_basic_draw(ctx, cell_layer, "Endurance", "Before take-off", s_gas_bitmap);
+      menu_cell_basic_draw(ctx, cell_layer, "Exit", "Long-press back", s_exit_bitmap);
       break;
     case 3:
+      menu_cell_basic_draw(ctx, cell_layer, "Endurance", "Before take-off", s_gas_bitmap);
+      break;
+    case 4:
       menu_cell_basic_draw(ctx, cell_layer, "Flight plan", alarm_is_inhibited(ALARM_FLIGHT_PLAN) ? "Set reminder" : "Flight plan closed?", s_charlie_bitmap);
       break;
+    case 5: {
+      static char s_logbook_buffer[32]; // "Sync 65535 of 65535 flights"
+      if (export_is_running()) {
+        strcpy(s_logbook_buffer, "Syncing...");
+      } else if (logbook_dirty_count() > 0) {
+        snprintf(s_logbook_buffer, sizeof(s_logbook_buffer), "Sync %d of %d flights", logbook_dirty_count(), logbook_count());
+      } else {
+        snprintf(s_logbook_buffer, sizeof(s_logbook_buffer), "%d flights in sync", logbook_count());
+      }
+      menu_cell_basic_draw(ctx, cell_layer, "Logbook", s_logbook_buffer, s_check_bitmap);
+      break;
+    }
+    case 6:
+      menu_cell_basic_draw(ctx, cell_layer, "Nav log", !flight_plan_is_loaded() ? "No flight plan" : navlog_is_enabled() ? "Up: waypoints" : "Disabled", s_charlie_bitmap);
+      break;
+    case 7:
+      menu_cell_basic_draw(ctx, cell_layer, "Checklist", mission_get_checklist() == CHECKLIST_NONE ? "None for this phase" : checklist_get_title(mission_get_checklist()), s_check_bitmap);
+      break;
+    case 8:
+      menu_cell_basic_draw(ctx, cell_layer, "Fuel", "Endurance from burn", s_gas_bitmap);
+      break;
+    case 9:
+      menu_cell_basic_draw(ctx, cell_layer, "Stopwatch", elapsed_time_get_tenths() ? "Seconds only" : "Show tenths", s_check_bitmap);
+      break;
+    case 10: {
+      static char s_power_buffer[24];
+      uint32_t estimate = power_get_estimate(power_get_profile());
+      snprintf(s_power_buffer, sizeof(s_power_buffer), "%s, %d.%02d mAh/h", power_get_name(power_get_profile()),
+               (int)(estimate / 1000), (int)(estimate % 1000 / 10));
+      menu_cell_basic_draw(ctx, cell_layer, "Power", s_power_buffer, s_gas_bitmap);
+      break;
+    }
+    case 11:
+      menu_cell_basic_draw(ctx, cell_layer, "Timings", "Alarms and reminders", s_check_bitmap);
+      break;
+    case 12:
+      menu_cell_basic_draw(ctx, cell_layer, "Timeline", "Legs and endurance", s_charlie_bitmap);
+      break;
     default:
       break;
   }
@@ -47,6 +129,10 @@ static void select_callback(struct MenuLayer *menu_layer,
                                         MenuIndex *cell_index, void *context) {
   switch(cell_index->row) {
     case 0:
+      mission_touch_and_go();
+      window_stack_pop(true);
+      break;
+    case 1:
       if (alarm_is_inhibited(ALARM_CRUISE_CHECK)) {
         alarm_enable(ALARM_CRUISE_CHECK);
       } else {
@@ -54,13 +140,16 @@ static void select_callback(struct MenuLayer *menu_layer,
       }
       window_stack_pop(true);
       break;
-    case 1:
+    case 2:
       window_stack_pop_all(true);
       break;
-    case 2:
-      time_window_push(s_time_window, true, endurance_get_takeoff_value());
+    case 3: {
+      time_t endurance = endurance_get_takeoff_value();
+      int16_t values[] = { endurance / SECONDS_PER_HOUR, endurance / SECONDS_PER_MINUTE % 60 };
+      entry_window_push(&s_endurance_entry, values);
       break;
-    case 3:
+    }
+    case 4:
       if (alarm_is_inhibited(ALARM_FLIGHT_PLAN)) {
         alarm_enable(ALARM_FLIGHT_PLAN);
       } else {
@@ -68,19 +157,65 @@ static void select_callback(struct MenuLayer *menu_layer,
       }
       menu_layer_reload_data(s_menu_layer);
       break;
+    case 5:
+      export_start(logbook_synced());
+      menu_layer_reload_data(s_menu_layer);
+      break;
+    case 6:
+      navlog_set_enabled(!navlog_is_enabled());
+      menu_layer_reload_data(s_menu_layer);
+      break;
+    case 7:
+      checklist_window_push(mission_get_checklist());
+      break;
+    case 8:
+      entry_window_push(&s_fuel_entry, s_fuel_values);
+      break;
+    case 9:
+      elapsed_time_set_tenths(!elapsed_time_get_tenths());
+      window_stack_pop(true);
+      break;
+    case 10:
+      power_set_profile((power_get_profile() + 1) % POWER_PROFILE_COUNT);
+      menu_layer_reload_data(s_menu_layer);
+      break;
+    case 11:
+      settings_window_push();
+      break;
+    case 12:
+      timeline_window_push();
+      break;
     default:
       break;
   }
 }
 
+#if PROFILE
+// Hidden: long select on Exit opens the debug window
+static void select_long_callback(struct MenuLayer *menu_layer, 
+                                        MenuIndex *cell_index, void *context) {
+  if (cell_index->row == 2) {
+    debug_window_push();
+  }
+}
+#endif
 
-static void time_complete_callback(time_t time, void *context) {
-  endurance_set_takeoff_value(time);
-  time_window_pop((TimeWindow*)context, true);
+static void endurance_complete(const int16_t values[]) {
+  endurance_set_takeoff_value(values[0] * SECONDS_PER_HOUR + values[1] * SECONDS_PER_MINUTE);
 }
 
-static void window_load(Window *window) {
-  Layer *window_layer = window_get_root_layer(window);
+static void fuel_complete(const int16_t values[]) {
+  s_fuel_values[0] = values[0];
+  s_fuel_values[1] = values[1];
+  endurance_set_takeoff_value((time_t)values[0] * 10 * SECONDS_PER_HOUR / values[1]);
+}
+
+// Built at startup, the window and its bitmaps are then kept until exit
+static void create() {
+  s_main_window = window_create();
+  window_set_background_color(s_main_window, PBL_IF_COLOR_ELSE(GColorJaegerGreen, GColorWhite));
+  
+  Layer *window_layer = window_get_root_layer(s_main_window);
   GRect bounds = layer_get_bounds(window_layer);
   
   s_check_bitmap = gbitmap_create_with_resource(RESOURCE_ID_CONFIRM_SMALL);
@@ -89,7 +224,7 @@ static void window_load(Window *window) {
   s_charlie_bitmap = gbitmap_create_with_resource(RESOURCE_ID_CHARLIE);
 
   s_menu_layer = menu_layer_create(bounds);
-  menu_layer_set_click_config_onto_window(s_menu_layer, window);
+  menu_layer_set_click_config_onto_window(s_menu_layer, s_main_window);
 #if defined(PBL_COLOR)
   menu_layer_set_normal_colors(s_menu_layer, GColorBlack, GColorWhite);
   menu_layer_set_highlight_colors(s_menu_layer, GColorRed, GColorWhite);
@@ -100,19 +235,18 @@ static void window_load(Window *window) {
     .draw_row = draw_row_callback,
     .get_cell_height = get_cell_height_callback,
     .select_click = select_callback,
+#if PROFILE
+    .select_long_click = select_long_callback,
+#endif
   });
   
   layer_add_child(window_layer, menu_layer_get_layer(s_menu_layer));
-  
-  TimeWindowDefinition definition = {
-    .time_complete = time_complete_callback,
-    .main_text = "ENDURANCE",
-    .sub_text = "Enter endurance at take-off (hh:mm)"
-  };
-  s_time_window = time_window_create(definition);
 }
 
-static void window_unload(Window *window) {
+void flight_menu_deinit() {
+  if (s_main_window == NULL) {
+    return;
+  }
   menu_layer_destroy(s_menu_layer);
   
   gbitmap_destroy(s_check_bitmap);
@@ -120,20 +254,28 @@ static void window_unload(Window *window) {
   gbitmap_destroy(s_exit_bitmap);
   gbitmap_destroy(s_charlie_bitmap);
   
-  time_window_destroy(s_time_window);
+  entry_window_deinit();
+  settings_window_deinit();
+  timeline_window_deinit();
+  debug_window_deinit();
   
-  window_destroy(window);
+  window_destroy(s_main_window);
   s_main_window = NULL;
 }
 
-void flight_menu_window_push() {
-  if(!s_main_window) {
-    s_main_window = window_create();
-    window_set_background_color(s_main_window, PBL_IF_COLOR_ELSE(GColorJaegerGreen, GColorWhite));
-    window_set_window_handlers(s_main_window, (WindowHandlers) {
-      .load = window_load,
-      .unload = window_unload,
-    });
+void flight_menu_init() {
+  if (s_main_window == NULL) {
+    create();
   }
+  entry_window_init();
+  settings_window_init();
+  timeline_window_init();
+  debug_window_init();
+}
+
+void flight_menu_window_push() {
+  flight_menu_init();
+  menu_layer_reload_data(s_menu_layer);
+  menu_layer_set_selected_index(s_menu_layer, (MenuIndex) { .section = 0, .row = 0 }, MenuRowAlignTop, false);
   window_stack_push(s_main_window, true);
 }
@@ -1,3 +1,7 @@
 #pragma once
 
+// The menu window and its layers are created by flight_menu_init, along
+// with the entry, settings and timeline windows, and kept
+void flight_menu_init();
+void flight_menu_deinit();
 void flight_menu_window_push();
\ No newline at end of file
@@ -0,0 +1,117 @@
+#include <pebble.h>
+#include "settings_window.h"
+#include "entry_window.h"
+#include "../services/settings.h"
+#include "../utils.h"
+
+static Window *s_main_window;
+static MenuLayer *s_menu_layer;
+
+static setting_id_t s_editing;
+
+static void timing_complete(const int16_t values[]);
+
+static const EntryField s_timing_fields[] = {
+  { .min = 0, .max = 99, .step = 1, .fast_step = 5, .digits = 2, .width = 50 },
+  { .min = 0, .max = 59, .step = 1, .fast_step = 5, .digits = 2, .width = 50 }
+};
+
+// The main text is set to the name of the setting being edited
+static EntryDefinition s_timing_entry = {
+  .sub_text = "Minutes and seconds (mm:ss)",
+  .fields = s_timing_fields,
+  .field_count = ARRAY_LENGTH(s_timing_fields),
+  .complete = timing_complete
+};
+
+// One row per setting, then the reset
+static uint16_t get_num_rows_callback(MenuLayer *menu_layer, 
+                                      uint16_t section_index, void *context) {
+  return SETTING_COUNT + 1;
+}
+
+static void draw_row_callback(GContext *ctx, const Layer *cell_layer, 
+                                        MenuIndex *cell_index, void *context) {
+  if (cell_index->row == SETTING_COUNT) {
+    menu_cell_basic_draw(ctx, cell_layer, "Defaults", "Reset all timings", NULL);
+    return;
+  }
+  
+  static char s_buffer[8];
+  format_duration_mmss(settings_get(cell_index->row), s_buffer, sizeof(s_buffer));
+  menu_cell_basic_draw(ctx, cell_layer, settings_get_name(cell_index->row), s_buffer, NULL);
+}
+
+static int16_t get_cell_height_callback(struct MenuLayer *menu_layer, 
+                                        MenuIndex *cell_index, void *context) {
+  const int16_t cell_height = 40;
+  return cell_height;
+}
+
+static void select_callback(struct MenuLayer *menu_layer, 
+                                        MenuIndex *cell_index, void *context) {
+  if (cell_index->row == SETTING_COUNT) {
+    settings_reset();
+    menu_layer_reload_data(s_menu_layer);
+    return;
+  }
+  
+  s_editing = cell_index->row;
+  uint16_t value = settings_get(s_editing);
+  int16_t values[] = { value / SECONDS_PER_MINUTE, value % SECONDS_PER_MINUTE };
+  s_timing_entry.main_text = settings_get_name(s_editing);
+  entry_window_push(&s_timing_entry, values);
+}
+
+static void timing_complete(const int16_t values[]) {
+  settings_set(s_editing, values[0] * SECONDS_PER_MINUTE + values[1]);
+}
+
+static void window_appear(Window *window) {
+  menu_layer_reload_data(s_menu_layer);
+}
+
+static void create() {
+  s_main_window = window_create();
+  window_set_background_color(s_main_window, PBL_IF_COLOR_ELSE(GColorJaegerGreen, GColorWhite));
+  window_set_window_handlers(s_main_window, (WindowHandlers) {
+    .appear = window_appear,
+  });
+  
+  Layer *window_layer = window_get_root_layer(s_main_window);
+  s_menu_layer = menu_layer_create(layer_get_bounds(window_layer));
+  menu_layer_set_click_config_onto_window(s_menu_layer, s_main_window);
+#if defined(PBL_COLOR)
+  menu_layer_set_normal_colors(s_menu_layer, GColorBlack, GColorWhite);
+  menu_layer_set_highlight_colors(s_menu_layer, GColorRed, GColorWhite);
+#endif
+  
+  menu_layer_set_callbacks(s_menu_layer, NULL, (MenuLayerCallbacks) {
+    .get_num_rows = get_num_rows_callback,
+    .draw_row = draw_row_callback,
+    .get_cell_height = get_cell_height_callback,
+    .select_click = select_callback,
+  });
+  layer_add_child(window_layer, menu_layer_get_layer(s_menu_layer));
+}
+
+void settings_window_deinit() {
+  if (s_main_window == NULL) {
+    return;
+  }
+  menu_layer_destroy(s_menu_layer);
+  window_destroy(s_main_window);
+  s_main_window = NULL;
+}
+
+void settings_window_init() {
+  if (s_main_window == NULL) {
+    create();
+  }
+}
+
+void settings_window_push() {
+  settings_window_init();
+  menu_layer_set_selected_index(s_menu_layer, (MenuIndex) { .section = 0, .row = 0 }, MenuRowAlignTop, false);
+  window_stack_push(s_main_window, true);
+}
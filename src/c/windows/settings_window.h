@@ -0,0 +1,8 @@
+#pragma once
+
+// Alarm and reminder timings, opened from the flight menu. Each row opens
+// the entry window on the mm:ss of the setting. Created by
+// settings_window_init, from flight_menu_init.
+void settings_window_init();
+void settings_window_deinit();
+void settings_window_push();
@@ -0,0 +1,435 @@
+#include <pebble.h>
+#include "timeline_window.h"
+#include "../layout.h"
+#include "../utils.h"
+#include "../components/mission.h"
+#include "../components/endurance.h"
+#include "../components/navlog.h"
+#include "../services/profile.h"
+
+// The chart is drawn into the frame buffer and copied out into s_chart,
+// later frames only blit it. On colour platforms the copy is reduced to a
+// 2-bit palette, a quarter of the frame buffer.
+
+#define TIMELINE_MIN_SPAN (2 * SECONDS_PER_HOUR)
+#define TIMELINE_MAX_ROW_HEIGHT 14
+#define TIMELINE_LABEL_WIDTH 20
+#define TIMELINE_LABEL_SPACING 24
+#define TIMELINE_TICK_HEIGHT 3
+
+#define TIMELINE_FLIGHT_COLOR PBL_IF_COLOR_ELSE(GColorPictonBlue, GColorWhite)
+#define TIMELINE_FUEL_COLOR PBL_IF_COLOR_ELSE(GColorOrange, GColorWhite)
+#define TIMELINE_NOW_COLOR PBL_IF_COLOR_ELSE(GColorRed, GColorWhite)
+
+static Window *s_main_window;
+static Layer *s_chart_layer;
+static GBitmap *s_chart; // the chart as last drawn, NULL if it could not be allocated
+static bool s_stale = true;
+static bool s_visible;
+
+static time_t s_start; // clock times at the left and right edges of the chart
+static time_t s_end;
+static int16_t s_now_x = -1;
+static char s_title[24];
+
+#ifdef PBL_COLOR
+static GColor s_palette[4];
+static uint8_t s_palette_index[64]; // nearest palette entry of each colour
+#endif
+
+static int16_t x_of(time_t t) {
+  GRect legs = LAYOUT_TIMELINE_LEGS;
+  if (t <= s_start) {
+    return legs.origin.x;
+  }
+  if (t >= s_end) {
+    return legs.origin.x + legs.size.w - 1;
+  }
+  return legs.origin.x + (t - s_start) * (legs.size.w - 1) / (s_end - s_start);
+}
+
+static bool is_current(uint8_t index) {
+  return index == mission_get_sector_count() - 1;
+}
+
+// The endurance of a finished sector is the one it was logged with
+static time_t sector_endurance(uint8_t index) {
+  const sector_t *sector = mission_get_sector(index);
+  return is_current(index) && sector->on_block == 0 ? endurance_get_takeoff_value() : sector->endurance;
+}
+
+// Where the flight under way is expected to end: the ETA of the nav log,
+// else when the tanks run dry, 0 if neither is known
+static time_t planned_landing(const sector_t *sector, time_t endurance) {
+  time_t eta = mission_get_timestamp(ETA);
+  if (eta != 0) {
+    return eta;
+  }
+  return endurance != 0 ? sector->take_off + endurance : 0;
+}
+
+// From the hour of the first off-block to the hour after the last time
+// drawn, so the chart only moves when the current time runs off its end
+static void set_span(time_t now) {
+  time_t first = mission_get_sector(0)->off_block;
+  time_t last = now;
+  uint8_t index = mission_get_sector_count() - 1;
+  const sector_t *sector = mission_get_sector(index);
+  time_t endurance = sector_endurance(index);
+  if (sector->take_off != 0 && endurance != 0 && sector->take_off + endurance > last) {
+    last = sector->take_off + endurance;
+  }
+  if (mission_is_in_flight() && planned_landing(sector, endurance) > last) {
+    last = planned_landing(sector, endurance);
+  }
+
+  s_start = first != 0 ? first : now;
+  s_start -= s_start % SECONDS_PER_HOUR;
+  s_end = last - last % SECONDS_PER_HOUR + SECONDS_PER_HOUR;
+  if (s_end - s_start < TIMELINE_MIN_SPAN) {
+    s_end = s_start + TIMELINE_MIN_SPAN;
+  }
+}
+
+static void draw_title(GContext *ctx) {
+  uint8_t legs = 0;
+  time_t block_time = 0;
+  for (uint8_t i = 0; i < mission_get_sector_count(); i++) {
+    const sector_t *sector = mission_get_sector(i);
+    if (sector->off_block != 0) {
+      legs++;
+    }
+    if (sector->on_block != 0) {
+      block_time += sector->on_block - sector->off_block;
+    }
+  }
+
+  if (legs == 0) {
+    strcpy(s_title, "No flight yet");
+  } else if (block_time == 0) {
+    snprintf(s_title, sizeof(s_title), "%d leg%s", legs, legs > 1 ? "s" : "");
+  } else {
+    char duration[6];
+    format_duration_hhmm(block_time, duration, sizeof(duration));
+    snprintf(s_title, sizeof(s_title), "%d leg%s, BT %s", legs, legs > 1 ? "s" : "", duration);
+  }
+  graphics_context_set_text_color(ctx, GColorWhite);
+  graphics_draw_text(ctx, s_title, fonts_get_system_font(FONT_KEY_GOTHIC_18_BOLD), LAYOUT_TIMELINE_TITLE,
+                     GTextOverflowModeTrailingEllipsis, GTextAlignmentCenter, NULL);
+}
+
+// A tick on every hour, labelled in UTC as often as the labels fit
+static void draw_axis(GContext *ctx) {
+  GRect axis = LAYOUT_TIMELINE_AXIS;
+  GRect fuel = LAYOUT_TIMELINE_FUEL;
+  int hours = (s_end - s_start) / SECONDS_PER_HOUR;
+  int gaps = axis.size.w / TIMELINE_LABEL_SPACING - 1;
+  int step = (hours + gaps - 1) / gaps;
+
+  graphics_context_set_fill_color(ctx, GColorWhite);
+  graphics_context_set_text_color(ctx, GColorWhite);
+  graphics_fill_rect(ctx, GRect(axis.origin.x, fuel.origin.y + fuel.size.h - 1, axis.size.w, 1), 0, GCornerNone);
+
+  for (int hour = 0; hour <= hours; hour++) {
+    time_t t = s_start + hour * SECONDS_PER_HOUR;
+    int16_t x = x_of(t);
+    graphics_fill_rect(ctx, GRect(x, axis.origin.y - TIMELINE_TICK_HEIGHT, 1, TIMELINE_TICK_HEIGHT), 0, GCornerNone);
+    if (hour % step != 0) {
+      continue;
+    }
+
+    char label[4];
+    uint8_t hour_of_day = t / SECONDS_PER_HOUR % 24;
+    snprintf(label, sizeof(label), "%02d", hour_of_day);
+    GRect box = GRect(x - TIMELINE_LABEL_WIDTH / 2, axis.origin.y, TIMELINE_LABEL_WIDTH, axis.size.h);
+    if (box.origin.x < axis.origin.x) {
+      box.origin.x = axis.origin.x;
+    } else if (box.origin.x + box.size.w > axis.origin.x + axis.size.w) {
+      box.origin.x = axis.origin.x + axis.size.w - box.size.w;
+    }
+    graphics_draw_text(ctx, label, fonts_get_system_font(FONT_KEY_GOTHIC_14), box,
+                       GTextOverflowModeFill, GTextAlignmentCenter, NULL);
+  }
+}
+
+static void draw_dotted(GContext *ctx, int16_t from, int16_t to, int16_t y) {
+  for (int16_t x = from; x <= to; x += 2) {
+    graphics_fill_rect(ctx, GRect(x, y, 1, 1), 0, GCornerNone);
+  }
+}
+
+static void draw_span(GContext *ctx, time_t from, time_t to, int16_t y, int16_t h) {
+  graphics_fill_rect(ctx, GRect(x_of(from), y, x_of(to) - x_of(from) + 1, h), 0, GCornerNone);
+}
+
+// Taxi as a line and the flight as a bar. The phase under way runs dotted
+// or hollow to where it should end, the current time marker shows how far
+// it has got.
+static void draw_sector(GContext *ctx, uint8_t index, GRect row) {
+  const sector_t *sector = mission_get_sector(index);
+  int16_t middle = row.origin.y + row.size.h / 2;
+  GRect bar = GRect(x_of(sector->take_off), row.origin.y + 1, 0, row.size.h - 2);
+
+  graphics_context_set_fill_color(ctx, GColorWhite);
+  if (sector->off_block == 0) {
+    return;
+  }
+  if (sector->take_off == 0) {
+    draw_dotted(ctx, x_of(sector->off_block), x_of(s_end), middle);
+    return;
+  }
+  draw_span(ctx, sector->off_block, sector->take_off, middle, 1);
+
+  if (is_current(index) && mission_is_in_flight()) {
+    time_t landing = planned_landing(sector, sector_endurance(index));
+    bar.size.w = x_of(landing != 0 ? landing : s_end) - bar.origin.x + 1;
+    graphics_context_set_stroke_color(ctx, TIMELINE_FLIGHT_COLOR);
+    graphics_draw_rect(ctx, bar);
+
+    const time_t *crossings;
+    uint8_t count = navlog_get_crossings(&crossings);
+    for (uint8_t i = 0; i < count; i++) {
+      graphics_fill_rect(ctx, GRect(x_of(crossings[i]), row.origin.y, 1, row.size.h), 0, GCornerNone);
+    }
+    return;
+  }
+
+  bar.size.w = x_of(sector->landing) - bar.origin.x + 1;
+  graphics_context_set_fill_color(ctx, TIMELINE_FLIGHT_COLOR);
+  graphics_fill_rect(ctx, bar, 0, GCornerNone);
+  graphics_context_set_fill_color(ctx, GColorWhite);
+  if (sector->on_block == 0) {
+    draw_dotted(ctx, x_of(sector->landing), x_of(s_end), middle);
+  } else {
+    draw_span(ctx, sector->landing, sector->on_block, middle, 1);
+  }
+}
+
+static void draw_legs(GContext *ctx) {
+  GRect legs = LAYOUT_TIMELINE_LEGS;
+  uint8_t count = mission_get_sector_count();
+  int16_t row_height = legs.size.h / count < TIMELINE_MAX_ROW_HEIGHT ? legs.size.h / count : TIMELINE_MAX_ROW_HEIGHT;
+  for (uint8_t i = 0; i < count; i++) {
+    draw_sector(ctx, i, GRect(legs.origin.x, legs.origin.y + i * row_height, legs.size.w, row_height));
+  }
+}
+
+// Endurance left against the clock, from take-off to landing, or to the
+// tanks running dry for the flight under way. All flights share the scale
+// of the longest endurance.
+static void draw_fuel(GContext *ctx) {
+  GRect fuel = LAYOUT_TIMELINE_FUEL;
+  uint8_t count = mission_get_sector_count();
+  time_t scale = 0;
+  for (uint8_t i = 0; i < count; i++) {
+    if (mission_get_sector(i)->take_off != 0 && sector_endurance(i) > scale) {
+      scale = sector_endurance(i);
+    }
+  }
+  if (scale == 0) {
+    return;
+  }
+
+  int16_t bottom = fuel.origin.y + fuel.size.h - 1;
+  graphics_context_set_stroke_color(ctx, TIMELINE_FUEL_COLOR);
+  for (uint8_t i = 0; i < count; i++) {
+    const sector_t *sector = mission_get_sector(i);
+    time_t endurance = sector_endurance(i);
+    if (sector->take_off == 0 || endurance == 0) {
+      continue;
+    }
+
+    GPoint full = GPoint(x_of(sector->take_off), bottom - endurance * (fuel.size.h - 1) / scale);
+    time_t dry = sector->take_off + endurance;
+    bool landed = !(is_current(i) && mission_is_in_flight()) && sector->landing != 0;
+    if (landed && sector->landing < dry) {
+      time_t left = dry - sector->landing;
+      graphics_draw_line(ctx, full, GPoint(x_of(sector->landing), bottom - left * (fuel.size.h - 1) / scale));
+      continue;
+    }
+    graphics_draw_line(ctx, full, GPoint(x_of(dry), bottom));
+    if (landed) {
+      graphics_draw_line(ctx, GPoint(x_of(dry), bottom), GPoint(x_of(sector->landing), bottom));
+    }
+  }
+}
+
+static void draw_chart(GContext *ctx, GRect bounds, time_t now) {
+  set_span(now);
+  graphics_context_set_fill_color(ctx, GColorBlack);
+  graphics_fill_rect(ctx, bounds, 0, GCornerNone);
+  draw_title(ctx);
+  draw_axis(ctx);
+  draw_legs(ctx);
+  draw_fuel(ctx);
+}
+
+#ifdef PBL_COLOR
+static int channel_distance(uint8_t a, uint8_t b, int shift) {
+  int difference = (a >> shift & 0x3) - (b >> shift & 0x3);
+  return difference < 0 ? -difference : difference;
+}
+
+static void init_palette() {
+  s_palette[0] = GColorBlack;
+  s_palette[1] = GColorWhite;
+  s_palette[2] = TIMELINE_FLIGHT_COLOR;
+  s_palette[3] = TIMELINE_FUEL_COLOR;
+
+  for (int color = 0; color < 64; color++) {
+    int best = 0;
+    int best_distance = 10;
+    for (int i = 0; i < 4; i++) {
+      int distance = channel_distance(color, s_palette[i].argb, 4) + channel_distance(color, s_palette[i].argb, 2)
+        + channel_distance(color, s_palette[i].argb, 0);
+      if (distance < best_distance) {
+        best = i;
+        best_distance = distance;
+      }
+    }
+    s_palette_index[color] = best;
+  }
+}
+#endif
+
+static GBitmap *create_chart_bitmap(GSize size) {
+#ifdef PBL_COLOR
+  return gbitmap_create_blank_with_palette(size, GBitmapFormat2BitPalette, s_palette, false);
+#else
+  return gbitmap_create_blank(size, GBitmapFormat1Bit);
+#endif
+}
+
+// The layer fills the screen, so its rows are the frame buffer rows.
+// Anti-aliased text edges go to the nearest colour of the palette.
+static void cache_chart(GContext *ctx, GRect bounds) {
+  if (s_chart == NULL) {
+    return;
+  }
+  GBitmap *frame_buffer = graphics_capture_frame_buffer(ctx);
+  if (frame_buffer == NULL) {
+    s_stale = true;
+    return;
+  }
+
+  uint8_t *data = gbitmap_get_data(s_chart);
+  uint16_t row_size = gbitmap_get_bytes_per_row(s_chart);
+  for (int y = 0; y < bounds.size.h; y++) {
+    GBitmapDataRowInfo info = gbitmap_get_data_row_info(frame_buffer, y);
+    uint8_t *row = data + y * row_size;
+#ifdef PBL_COLOR
+    memset(row, 0, row_size);
+    for (int x = info.min_x; x <= info.max_x && x < bounds.size.w; x++) {
+      row[x / 4] |= s_palette_index[info.data[x] & 0x3F] << (6 - x % 4 * 2);
+    }
+#else
+    memcpy(row, info.data, row_size < gbitmap_get_bytes_per_row(frame_buffer) ? row_size : gbitmap_get_bytes_per_row(frame_buffer));
+#endif
+  }
+  graphics_release_frame_buffer(ctx, frame_buffer);
+}
+
+static void draw_now(GContext *ctx, time_t now) {
+  GRect legs = LAYOUT_TIMELINE_LEGS;
+  GRect fuel = LAYOUT_TIMELINE_FUEL;
+  s_now_x = x_of(now);
+  if (now < s_start || now > s_end) {
+    return;
+  }
+  // Edged in black to stand out on the bars
+  int16_t top = legs.origin.y - 2;
+  int16_t height = fuel.origin.y + fuel.size.h - top;
+  graphics_context_set_fill_color(ctx, GColorBlack);
+  graphics_fill_rect(ctx, GRect(s_now_x - 1, top, 3, height), 0, GCornerNone);
+  graphics_context_set_fill_color(ctx, TIMELINE_NOW_COLOR);
+  graphics_fill_rect(ctx, GRect(s_now_x, top, 1, height), 0, GCornerNone);
+}
+
+static void draw(Layer *layer, GContext *ctx) {
+  GRect bounds = layer_get_bounds(layer);
+  time_t now = time(NULL);
+
+  if (s_stale || s_chart == NULL) {
+    draw_chart(ctx, bounds, now);
+    s_stale = false;
+    cache_chart(ctx, bounds);
+  } else {
+    graphics_context_set_compositing_mode(ctx, GCompOpAssign);
+    graphics_draw_bitmap_in_rect(ctx, s_chart, bounds);
+  }
+  draw_now(ctx, now);
+}
+
+static void update_proc(Layer *layer, GContext *ctx) {
+  PROFILE_CALL(PROFILE_DRAW_TIMELINE, draw(layer, ctx));
+}
+
+static void window_appear(Window *window) {
+  s_visible = true;
+}
+
+static void window_disappear(Window *window) {
+  s_visible = false;
+}
+
+static void create() {
+  s_main_window = window_create();
+  window_set_background_color(s_main_window, GColorBlack);
+
+  Layer *window_layer = window_get_root_layer(s_main_window);
+  s_chart_layer = layer_create(layer_get_bounds(window_layer));
+  layer_set_update_proc(s_chart_layer, update_proc);
+  layer_add_child(window_layer, s_chart_layer);
+#ifdef PBL_COLOR
+  init_palette();
+#endif
+  // With the window, before any off-block, so that no draw in flight allocates
+  s_chart = create_chart_bitmap(layer_get_bounds(window_layer).size);
+
+  window_set_window_handlers(s_main_window, (WindowHandlers) {
+    .appear = window_appear,
+    .disappear = window_disappear
+  });
+}
+
+void timeline_window_deinit() {
+  if (s_main_window == NULL) {
+    return;
+  }
+  if (s_chart != NULL) {
+    gbitmap_destroy(s_chart);
+    s_chart = NULL;
+  }
+  layer_destroy(s_chart_layer);
+  window_destroy(s_main_window);
+  s_main_window = NULL;
+}
+
+void timeline_window_init() {
+  if (s_main_window == NULL) {
+    create();
+  }
+}
+
+void timeline_window_push() {
+  timeline_window_init();
+  window_stack_push(s_main_window, true);
+}
+
+void timeline_window_invalidate() {
+  s_stale = true;
+  if (s_visible) {
+    layer_mark_dirty(s_chart_layer);
+  }
+}
+
+void timeline_window_update(time_t tick) {
+  if (!s_visible) {
+    return;
+  }
+  if (tick > s_end) {
+    timeline_window_invalidate();
+  } else if (x_of(tick) != s_now_x) {
+    layer_mark_dirty(s_chart_layer);
+  }
+}
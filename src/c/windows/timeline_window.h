@@ -0,0 +1,15 @@
+#pragma once
+#include <pebble.h>
+
+// The legs of the day against the clock with the endurance below, opened
+// from the flight menu. The chart is drawn into a bitmap when the mission
+// or the nav log changes, only the marker of the current time is redrawn
+// on the ticks. Created by timeline_window_init, from flight_menu_init.
+void timeline_window_init();
+void timeline_window_deinit();
+void timeline_window_push();
+
+// The chart is redrawn on its next frame
+void timeline_window_invalidate();
+// Moves the current time marker, nothing to do unless the window is shown
+void timeline_window_update(time_t tick);
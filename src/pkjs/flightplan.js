@@ -0,0 +1,83 @@
+// Flight plan import. The plan is encoded in the compact layout decoded by
+// src/c/services/flight_plan.c and sent to the watch in a single message.
+//
+// A plan is stored in localStorage under 'flightplan.pending' as JSON:
+//   { "departure": "LSGG", "alternate": "LSGS", "fuel": 120.0,
+//     "reserveBurn": 28.0, "alternateMinutes": 25,
+//     "legs": [ { "to": "PAS", "minutes": 14, "burn": 30.0 }, ... ] }
+// Fuel quantities and burn rates share one unit (litres, gallons...).
+
+var VERSION = 1;
+var MAX_LEGS = 16;
+var STATUS = ['ok', 'bad length', 'bad version', 'bad checksum', 'bad content'];
+
+function writeUint16(bytes, value) {
+  value = Math.max(0, Math.min(0xffff, Math.round(value)));
+  bytes.push(value & 0xff, value >> 8);
+}
+
+function writeIdent(bytes, ident) {
+  ident = (ident || '').toUpperCase();
+  for (var i = 0; i < 4; i++) {
+    bytes.push(i < ident.length ? ident.charCodeAt(i) : 0);
+  }
+}
+
+function fletcher16(bytes) {
+  var sum1 = 0;
+  var sum2 = 0;
+  for (var i = 0; i < bytes.length; i++) {
+    sum1 = (sum1 + bytes[i]) % 255;
+    sum2 = (sum2 + sum1) % 255;
+  }
+  return (sum2 << 8) | sum1;
+}
+
+function encode(plan) {
+  if (!plan.legs || plan.legs.length === 0 || plan.legs.length > MAX_LEGS) {
+    throw new Error('a flight plan needs 1 to ' + MAX_LEGS + ' legs');
+  }
+
+  var bytes = [VERSION, plan.legs.length];
+  writeIdent(bytes, plan.departure);
+  writeIdent(bytes, plan.alternate);
+  writeUint16(bytes, plan.fuel * 10);
+  writeUint16(bytes, plan.reserveBurn * 10);
+  writeUint16(bytes, (plan.alternateMinutes || 0) * 60);
+  plan.legs.forEach(function(leg) {
+    writeIdent(bytes, leg.to);
+    writeUint16(bytes, leg.minutes * 60);
+    writeUint16(bytes, leg.burn * 10);
+  });
+  writeUint16(bytes, fletcher16(bytes));
+  return bytes;
+}
+
+function send(plan) {
+  Pebble.sendAppMessage({ 'FlightPlan': encode(plan) }, function() {
+    console.log('Flight plan sent (' + plan.legs.length + ' legs)');
+  }, function() {
+    console.log('Flight plan not delivered');
+  });
+}
+
+function sendPending() {
+  var pending = localStorage.getItem('flightplan.pending');
+  if (pending) {
+    send(JSON.parse(pending));
+  }
+}
+
+function onReply(status) {
+  console.log('Flight plan ' + (STATUS[status] || status));
+  if (status === 0) {
+    localStorage.removeItem('flightplan.pending');
+  }
+}
+
+module.exports = {
+  encode: encode,
+  send: send,
+  sendPending: sendPending,
+  onReply: onReply
+};
@@ -0,0 +1,27 @@
+var logbook = require('./logbook');
+var flightplan = require('./flightplan');
+var settings = require('./settings');
+
+Pebble.addEventListener('ready', function() {
+  console.log('FlightLevel companion ready');
+  flightplan.sendPending();
+  settings.sendPending();
+  logbook.sendPendingPatches();
+});
+
+Pebble.addEventListener('appmessage', function(e) {
+  var payload = e.payload;
+  if (payload.Chunk !== undefined) {
+    logbook.onChunk(payload);
+  } else if (payload.FlightPlan !== undefined) {
+    flightplan.onReply(payload.FlightPlan);
+  } else if (payload.Settings !== undefined) {
+    settings.onReply(payload.Settings);
+  } else if (payload.Patch !== undefined) {
+    logbook.onPatchReply(payload.Patch, payload.Sequence);
+  }
+});
+
+Pebble.addEventListener('showConfiguration', function() {
+  logbook.requestSync();
+});
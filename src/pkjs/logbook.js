@@ -0,0 +1,308 @@
+// Receiving end of the logbook sync. Chunks carry packed flight records
+// (see flight_t in src/c/services/logbook.h), they are acknowledged
+// cumulatively so the watch can keep several of them in flight.
+//
+// Every change on the watch takes a sequence number. The flights are kept
+// in localStorage under 'logbook.records', by number, with the last
+// sequence number received under 'logbook.synced': a sync only asks for
+// the flights changed since.
+//
+// Corrected times are stored under 'logbook.patches' as JSON, in seconds,
+// e.g. [{ "number": 12, "offBlock": 1700000000, "takeOff": 1700000600,
+// "landing": 1700004200, "onBlock": 1700004500 }]. They are sent one at a
+// time when the app starts, in the layout decoded by logbook_patch().
+
+var COMMAND_START = 1;
+var NIGHT_UNKNOWN = 0xffff;
+var FLIGHT_EDITED = 0x01;
+var PATCH_VERSION = 1;
+var PATCH_STATUS = ['ok', 'bad length', 'bad version', 'bad checksum', 'bad value', 'unknown flight', 'conflict'];
+var PATCH_OK = 0;
+
+var transfer = null;
+var requestedSince = null;
+
+function readUint32(bytes, offset) {
+  return (bytes[offset] | (bytes[offset + 1] << 8) | (bytes[offset + 2] << 16) | (bytes[offset + 3] << 24)) >>> 0;
+}
+
+function readUint16(bytes, offset) {
+  return bytes[offset] | (bytes[offset + 1] << 8);
+}
+
+function writeUint16(bytes, value) {
+  bytes.push(value & 0xff, (value >> 8) & 0xff);
+}
+
+function writeUint32(bytes, value) {
+  writeUint16(bytes, value & 0xffff);
+  writeUint16(bytes, value >>> 16);
+}
+
+function fletcher16(bytes) {
+  var sum1 = 0;
+  var sum2 = 0;
+  for (var i = 0; i < bytes.length; i++) {
+    sum1 = (sum1 + bytes[i]) % 255;
+    sum2 = (sum2 + sum1) % 255;
+  }
+  return (sum2 << 8) | sum1;
+}
+
+function readIdent(bytes, offset) {
+  var ident = '';
+  for (var i = 0; i < 4 && bytes[offset + i]; i++) {
+    ident += String.fromCharCode(bytes[offset + i]);
+  }
+  return ident;
+}
+
+function decodeFlight(bytes, offset, recordSize) {
+  var flight = {
+    offBlock: readUint32(bytes, offset),
+    takeOff: readUint32(bytes, offset + 4),
+    landing: readUint32(bytes, offset + 8),
+    onBlock: readUint32(bytes, offset + 12),
+    endurance: readUint16(bytes, offset + 16),
+    night: null,
+    landings: null,
+    departure: '',
+    destination: '',
+    number: null,
+    sequence: null,
+    edited: false
+  };
+  if (recordSize >= 28) {
+    var night = readUint16(bytes, offset + 18);
+    flight.night = night === NIGHT_UNKNOWN ? null : night;
+    flight.departure = readIdent(bytes, offset + 20);
+    flight.destination = readIdent(bytes, offset + 24);
+  }
+  if (recordSize >= 29) {
+    flight.landings = bytes[offset + 28];
+  }
+  if (recordSize >= 34) {
+    flight.number = readUint16(bytes, offset + 29);
+    flight.sequence = readUint16(bytes, offset + 31);
+    flight.edited = (bytes[offset + 33] & FLIGHT_EDITED) !== 0;
+  }
+  return flight;
+}
+
+function loadRecords() {
+  return JSON.parse(localStorage.getItem('logbook.records') || '{}');
+}
+
+function loadSynced() {
+  return parseInt(localStorage.getItem('logbook.synced'), 10) || 0;
+}
+
+function sortedFlights(records) {
+  return Object.keys(records).map(function(number) {
+    return records[number];
+  }).sort(function(a, b) {
+    return a.offBlock - b.offBlock;
+  });
+}
+
+function isoTime(seconds) {
+  return seconds ? new Date(seconds * 1000).toISOString() : '';
+}
+
+function toCsv(flights) {
+  var lines = ['departure,destination,off_block,take_off,landing,on_block,block_min,flight_min,night_min,landings,endurance_min,edited'];
+  flights.forEach(function(f) {
+    lines.push([
+      f.departure, f.destination,
+      isoTime(f.offBlock), isoTime(f.takeOff), isoTime(f.landing), isoTime(f.onBlock),
+      Math.round((f.onBlock - f.offBlock) / 60), Math.round((f.landing - f.takeOff) / 60),
+      f.night === null ? '' : f.night, f.landings === null ? '' : f.landings, f.endurance,
+      f.edited ? 1 : 0
+    ].join(','));
+  });
+  return lines.join('\n');
+}
+
+function toJson(flights) {
+  return JSON.stringify(flights.map(function(f) {
+    return {
+      departure: f.departure,
+      destination: f.destination,
+      offBlock: isoTime(f.offBlock),
+      takeOff: isoTime(f.takeOff),
+      landing: isoTime(f.landing),
+      onBlock: isoTime(f.onBlock),
+      night: f.night,
+      landings: f.landings,
+      endurance: f.endurance,
+      edited: f.edited
+    };
+  }));
+}
+
+function save(records, synced) {
+  var flights = sortedFlights(records);
+  localStorage.setItem('logbook.records', JSON.stringify(records));
+  localStorage.setItem('logbook.synced', String(synced));
+  localStorage.setItem('logbook.csv', toCsv(flights));
+  localStorage.setItem('logbook.json', toJson(flights));
+}
+
+function sendAck(count) {
+  Pebble.sendAppMessage({ 'Ack': count }, null, function() {
+    // a lost acknowledgement is recovered by the watch timing out and resending
+    console.log('Ack ' + count + ' not delivered');
+  });
+}
+
+function complete() {
+  var flights = [];
+  var bytes = 0;
+  transfer.chunks.forEach(function(chunk) {
+    bytes += chunk.length;
+    for (var offset = 0; offset + transfer.recordSize <= chunk.length; offset += transfer.recordSize) {
+      flights.push(decodeFlight(chunk, offset, transfer.recordSize));
+    }
+  });
+
+  var elapsed = Date.now() - transfer.started;
+  console.log('Logbook sync: ' + flights.length + ' records, ' + transfer.chunks.length + ' chunks, '
+    + bytes + ' bytes in ' + elapsed + ' ms ('
+    + (elapsed > 0 ? (flights.length * 1000 / elapsed).toFixed(1) : flights.length) + ' records/s, '
+    + transfer.duplicates + ' duplicate chunks)');
+
+  // Records without a number come from an older watch app, which always
+  // sends the whole logbook, as does a sync from 0
+  var full = transfer.recordSize < 34 || transfer.since === 0;
+  var records = full ? {} : loadRecords();
+  var synced = full ? 0 : loadSynced();
+  flights.forEach(function(flight, index) {
+    records[flight.number !== null ? flight.number : index] = flight;
+    synced = Math.max(synced, flight.sequence || 0);
+  });
+  save(records, synced);
+  console.log(toCsv(sortedFlights(records)));
+  transfer.done = true;
+}
+
+function onChunk(payload) {
+  var seq = payload.Seq;
+  if (transfer === null || (transfer.done && seq === 0)) {
+    transfer = {
+      started: Date.now(),
+      since: requestedSince,
+      chunks: [],
+      contiguous: 0,
+      duplicates: 0,
+      done: false
+    };
+    requestedSince = null;
+  }
+
+  transfer.recordSize = payload.RecordSize;
+  transfer.total = payload.Total;
+
+  if (transfer.chunks[seq] !== undefined) {
+    transfer.duplicates++;
+  } else {
+    transfer.chunks[seq] = payload.Chunk;
+  }
+  while (transfer.chunks[transfer.contiguous] !== undefined) {
+    transfer.contiguous++;
+  }
+  sendAck(transfer.contiguous);
+
+  var received = 0;
+  for (var i = 0; i < transfer.contiguous; i++) {
+    received += Math.floor(transfer.chunks[i].length / transfer.recordSize);
+  }
+  if (!transfer.done && received >= transfer.total) {
+    complete();
+  }
+}
+
+function request(since) {
+  transfer = null;
+  requestedSince = since;
+  Pebble.sendAppMessage({ 'Command': COMMAND_START, 'Since': since });
+}
+
+// The flights changed since the last sync
+function requestSync() {
+  request(loadSynced());
+}
+
+// The whole logbook, replaces the copy on the phone
+function requestExport() {
+  request(0);
+}
+
+function encodePatch(patch, sequence) {
+  var bytes = [PATCH_VERSION];
+  writeUint16(bytes, patch.number);
+  writeUint16(bytes, sequence);
+  writeUint32(bytes, patch.offBlock);
+  writeUint32(bytes, patch.takeOff);
+  writeUint32(bytes, patch.landing);
+  writeUint32(bytes, patch.onBlock);
+  writeUint16(bytes, fletcher16(bytes));
+  return bytes;
+}
+
+function loadPatches() {
+  return JSON.parse(localStorage.getItem('logbook.patches') || '[]');
+}
+
+// Patches go one at a time, the next one leaves on the reply
+function sendPendingPatches() {
+  var patches = loadPatches();
+  if (patches.length === 0) {
+    return;
+  }
+  var patch = patches[0];
+  var record = loadRecords()[patch.number];
+  if (!record || record.sequence === null) {
+    console.log('Logbook patch for flight ' + patch.number + ' dropped: not synced yet');
+    localStorage.setItem('logbook.patches', JSON.stringify(patches.slice(1)));
+    sendPendingPatches();
+    return;
+  }
+  var bytes = encodePatch(patch, record.sequence);
+  Pebble.sendAppMessage({ 'Patch': bytes }, function() {
+    console.log('Logbook patch for flight ' + patch.number + ' sent, ' + bytes.length + ' bytes');
+  }, function() {
+    console.log('Logbook patch for flight ' + patch.number + ' not delivered');
+  });
+}
+
+function onPatchReply(status, sequence) {
+  var patches = loadPatches();
+  var patch = patches.shift();
+  console.log('Logbook patch ' + (PATCH_STATUS[status] || status) + (patch ? ' for flight ' + patch.number : ''));
+  if (!patch) {
+    return;
+  }
+  if (status === PATCH_OK) {
+    // Kept as edited until the next sync brings the night time back
+    var records = loadRecords();
+    var record = records[patch.number];
+    record.offBlock = patch.offBlock;
+    record.takeOff = patch.takeOff;
+    record.landing = patch.landing;
+    record.onBlock = patch.onBlock;
+    record.sequence = sequence;
+    record.edited = true;
+    save(records, loadSynced());
+  }
+  // A conflict means the watch holds a newer copy, the next sync brings it
+  localStorage.setItem('logbook.patches', JSON.stringify(patches));
+  sendPendingPatches();
+}
+
+module.exports = {
+  onChunk: onChunk,
+  requestSync: requestSync,
+  requestExport: requestExport,
+  sendPendingPatches: sendPendingPatches,
+  onPatchReply: onPatchReply
+};
@@ -0,0 +1,79 @@
+// Alarm and reminder timings. All of them are sent to the watch in a single
+// message, in the layout decoded by src/c/services/settings.c.
+//
+// The timings are stored in localStorage under 'settings.pending' as JSON,
+// in seconds, e.g. { "cruiseCheck": 1200, "taxiOut": 45 }. Missing timings
+// keep the watch defaults.
+
+var VERSION = 1;
+var STATUS = ['ok', 'bad length', 'bad version', 'bad checksum', 'bad value'];
+
+// In the order of setting_id_t, with the watch defaults
+var FIELDS = [
+  ['cruiseCheck', 900],
+  ['cruiseCheckShown', 120],
+  ['fuelAlarm', 900],
+  ['fuelAlarmShown', 900],
+  ['planClosed', 300],
+  ['planClosedShown', 600],
+  ['batteryAlarm', 1800],
+  ['batteryAlarmShown', 120],
+  ['fuelReserve', 2700],
+  ['taxiOut', 30],
+  ['taxiIn', 60],
+  ['infoRevert', 3],
+  ['browseRevert', 10]
+];
+
+function writeUint16(bytes, value) {
+  value = Math.max(0, Math.min(0xffff, Math.round(value)));
+  bytes.push(value & 0xff, value >> 8);
+}
+
+function fletcher16(bytes) {
+  var sum1 = 0;
+  var sum2 = 0;
+  for (var i = 0; i < bytes.length; i++) {
+    sum1 = (sum1 + bytes[i]) % 255;
+    sum2 = (sum2 + sum1) % 255;
+  }
+  return (sum2 << 8) | sum1;
+}
+
+function encode(settings) {
+  var bytes = [VERSION];
+  FIELDS.forEach(function(field) {
+    writeUint16(bytes, settings[field[0]] !== undefined ? settings[field[0]] : field[1]);
+  });
+  writeUint16(bytes, fletcher16(bytes));
+  return bytes;
+}
+
+function send(settings) {
+  Pebble.sendAppMessage({ 'Settings': encode(settings) }, function() {
+    console.log('Settings sent');
+  }, function() {
+    console.log('Settings not delivered');
+  });
+}
+
+function sendPending() {
+  var pending = localStorage.getItem('settings.pending');
+  if (pending) {
+    send(JSON.parse(pending));
+  }
+}
+
+function onReply(status) {
+  console.log('Settings ' + (STATUS[status] || status));
+  if (status === 0) {
+    localStorage.removeItem('settings.pending');
+  }
+}
+
+module.exports = {
+  encode: encode,
+  send: send,
+  sendPending: sendPending,
+  onReply: onReply
+};
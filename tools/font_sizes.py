@@ -0,0 +1,53 @@
+#!/usr/bin/env python3
+"""Report the size of the custom font resources for each platform.
+
+Run after `pebble build`:
+
+    tools/font_sizes.py [build]
+
+The SDK rasterizes each font resource of package.json into a .pfo file per
+platform, holding only the glyphs matched by its characterRegex. To compare
+with the full character set, drop characterRegex from the entry, rebuild and
+run this again. The heap taken by each font is logged by the watch when it
+is first loaded (see src/c/services/digit_font.c).
+"""
+
+import json
+import os
+import sys
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+
+def font_resources():
+    with open(os.path.join(ROOT, 'package.json')) as f:
+        media = json.load(f)['pebble']['resources']['media']
+    return [m for m in media if m['type'] == 'font']
+
+
+def main():
+    build = sys.argv[1] if len(sys.argv) > 1 else os.path.join(ROOT, 'build')
+    fonts = font_resources()
+    found = False
+
+    for platform in sorted(os.listdir(build)):
+        platform_dir = os.path.join(build, platform)
+        if not os.path.isdir(platform_dir):
+            continue
+        for dirpath, _, filenames in os.walk(platform_dir):
+            for filename in sorted(filenames):
+                if not filename.endswith('.pfo'):
+                    continue
+                for font in fonts:
+                    if font['name'] in filename:
+                        size = os.path.getsize(os.path.join(dirpath, filename))
+                        print('{:10} {:12} {:>7} bytes  {}'.format(
+                            platform, font['name'], size, font.get('characterRegex', 'all glyphs')))
+                        found = True
+
+    if not found:
+        sys.exit('no font resources under {}, run pebble build first'.format(build))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,40 @@
+#pragma once
+
+// Host side of the SDK stand-in: the driver owns the virtual clock and the
+// buttons, and is told about everything the app does to the outside world.
+#include "pebble.h"
+
+typedef struct HostHooks {
+  // Runs in place of the event loop, e.g. a scripted scenario
+  void (*event_loop)(void);
+  void (*log)(AppLogLevel level, const char *message);
+  void (*vibe)(const VibePattern *pattern);
+  void (*light)(void);
+  void (*data_logging)(uint32_t tag, const void *items, uint32_t count, uint16_t item_length);
+  // Once per glance reload, with the slices added (none clears the glance)
+  void (*glance)(const AppGlanceSlice *slices, size_t count);
+} HostHooks;
+
+void host_set_hooks(HostHooks hooks);
+
+// Virtual time in ms since the epoch
+void host_clock_set(time_t start);
+uint64_t host_clock_now(void);
+// Moves the clock forward, firing the timers and ticks that fall due
+void host_advance(uint32_t ms);
+
+// A click, or a button held for hold_ms: long click or repeated clicks
+// depending on what the top window subscribed
+void host_click(ButtonId button, uint32_t hold_ms);
+Window *host_top_window(void);
+
+// Draws the top window as the watch would show it, into a display sized
+// 8-bit ARGB frame owned by the stand-in. Round displays are masked.
+const GBitmap *host_render_frame(void);
+
+void host_set_battery(BatteryChargeState state);
+
+// Resource table generated by tools/simulate.py, indexed by resource id
+extern const char *const host_resource_names[];
+extern const char *const host_resource_files[];
+extern const uint32_t host_resource_count;
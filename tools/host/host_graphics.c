@@ -0,0 +1,484 @@
+// Software rasterizer of the SDK stand-in: bitmaps, fonts and the drawing
+// calls, rendering into an 8-bit ARGB frame buffer like basalt's. Text uses
+// the fixed-pitch glyphs of host_font.c scaled to the size of the font.
+
+#include "host_ui.h"
+
+#define HOST_TEXT_MAX 256
+#define HOST_TEXT_MAX_LINES 16
+
+static GBitmap *s_frame;
+static GContext s_context;
+
+GRect host_grect_intersect(GRect a, GRect b) {
+  int16_t x0 = a.origin.x > b.origin.x ? a.origin.x : b.origin.x;
+  int16_t y0 = a.origin.y > b.origin.y ? a.origin.y : b.origin.y;
+  int16_t x1 = a.origin.x + a.size.w < b.origin.x + b.size.w ? a.origin.x + a.size.w : b.origin.x + b.size.w;
+  int16_t y1 = a.origin.y + a.size.h < b.origin.y + b.size.h ? a.origin.y + a.size.h : b.origin.y + b.size.h;
+  if (x1 <= x0 || y1 <= y0) {
+    return GRect(x0, y0, 0, 0);
+  }
+  return GRect(x0, y0, x1 - x0, y1 - y0);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Bitmaps
+
+static uint8_t bits_per_pixel(GBitmapFormat format) {
+  switch (format) {
+    case GBitmapFormat1Bit:
+    case GBitmapFormat1BitPalette:
+      return 1;
+    case GBitmapFormat2BitPalette:
+      return 2;
+    case GBitmapFormat4BitPalette:
+      return 4;
+    default:
+      return 8;
+  }
+}
+
+GBitmap *gbitmap_create_blank(GSize size, GBitmapFormat format) {
+  GBitmap *bitmap = calloc(1, sizeof(GBitmap));
+  uint8_t bpp = bits_per_pixel(format);
+  // 1-bit rows are word aligned like on the watch
+  bitmap->row_size = format == GBitmapFormat1Bit ? (size.w + 31) / 32 * 4 : (size.w * bpp + 7) / 8;
+  bitmap->format = format;
+  bitmap->bounds = GRect(0, 0, size.w, size.h);
+  bitmap->data = calloc(size.h > 0 ? size.h : 1, bitmap->row_size > 0 ? bitmap->row_size : 1);
+  return bitmap;
+}
+
+GBitmap *gbitmap_create_blank_with_palette(GSize size, GBitmapFormat format, GColor *palette, bool free_on_destroy) {
+  GBitmap *bitmap = gbitmap_create_blank(size, format);
+  bitmap->palette = palette;
+  bitmap->free_palette = free_on_destroy;
+  return bitmap;
+}
+
+// Bitmap resources are converted by tools/simulate.py: "HBM1", uint16 width,
+// uint16 height, uint8 format, a pad byte, then the rows as in a GBitmap
+GBitmap *gbitmap_create_with_resource(uint32_t resource_id) {
+  ResHandle handle = resource_get_handle(resource_id);
+  uint8_t header[10];
+  if (resource_load_byte_range(handle, 0, header, sizeof(header)) != sizeof(header)
+      || memcmp(header, "HBM1", 4) != 0) {
+    return NULL;
+  }
+  GSize size = GSize(header[4] | header[5] << 8, header[6] | header[7] << 8);
+  GBitmap *bitmap = gbitmap_create_blank(size, header[8]);
+  resource_load_byte_range(handle, sizeof(header), bitmap->data, bitmap->row_size * size.h);
+  return bitmap;
+}
+
+void gbitmap_destroy(GBitmap *bitmap) {
+  if (!bitmap) {
+    return;
+  }
+  if (bitmap->free_palette) {
+    free(bitmap->palette);
+  }
+  free(bitmap->data);
+  free(bitmap);
+}
+
+uint8_t *gbitmap_get_data(const GBitmap *bitmap) {
+  return bitmap->data;
+}
+
+uint16_t gbitmap_get_bytes_per_row(const GBitmap *bitmap) {
+  return bitmap->row_size;
+}
+
+GBitmapFormat gbitmap_get_format(const GBitmap *bitmap) {
+  return bitmap->format;
+}
+
+GRect gbitmap_get_bounds(const GBitmap *bitmap) {
+  return bitmap->bounds;
+}
+
+void gbitmap_set_bounds(GBitmap *bitmap, GRect bounds) {
+  bitmap->bounds = bounds;
+}
+
+GColor *gbitmap_get_palette(const GBitmap *bitmap) {
+  return bitmap->palette;
+}
+
+GBitmapDataRowInfo gbitmap_get_data_row_info(const GBitmap *bitmap, uint16_t y) {
+  return (GBitmapDataRowInfo) {
+    .data = bitmap->data + y * bitmap->row_size,
+    .min_x = 0,
+    .max_x = bitmap->bounds.size.w - 1,
+  };
+}
+
+// Palette index or 1-bit value of a pixel, palettized rows are MSB first
+static uint8_t bitmap_index(const GBitmap *bitmap, int x, int y) {
+  const uint8_t *row = bitmap->data + y * bitmap->row_size;
+  uint8_t bpp = bits_per_pixel(bitmap->format);
+  if (bitmap->format == GBitmapFormat1Bit) {
+    return (row[x / 8] >> (x % 8)) & 1;
+  }
+  if (bpp == 8) {
+    return row[x];
+  }
+  int bit = x * bpp;
+  return (row[bit / 8] >> (8 - bpp - bit % 8)) & ((1 << bpp) - 1);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Fonts: one handle per name, sized from the number in it
+
+#define HOST_FONT_COUNT 16
+
+static struct HostFont s_fonts[HOST_FONT_COUNT];
+
+static GFont font_named(const char *name) {
+  for (int i = 0; i < HOST_FONT_COUNT; i++) {
+    if (strcmp(s_fonts[i].name, name) == 0) {
+      return &s_fonts[i];
+    }
+    if (s_fonts[i].name[0] == '\0') {
+      snprintf(s_fonts[i].name, sizeof(s_fonts[i].name), "%s", name);
+      const char *digits = strpbrk(name, "0123456789");
+      s_fonts[i].height = digits ? atoi(digits) : 14;
+      s_fonts[i].scale = s_fonts[i].height >= 24 ? (s_fonts[i].height + 4) / 14 : 1;
+      return &s_fonts[i];
+    }
+  }
+  return &s_fonts[0];
+}
+
+GFont fonts_get_system_font(const char *font_key) {
+  return font_named(font_key);
+}
+
+GFont fonts_load_custom_font(ResHandle handle) {
+  return font_named(handle < host_resource_count ? host_resource_names[handle] : "CUSTOM");
+}
+
+void fonts_unload_custom_font(GFont font) {
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Context
+
+GContext *host_graphics_context(void) {
+  if (!s_frame) {
+    s_frame = gbitmap_create_blank(GSize(PBL_DISPLAY_WIDTH, PBL_DISPLAY_HEIGHT), GBitmapFormat8Bit);
+  }
+  s_context = (GContext) {
+    .frame = s_frame,
+    .clip = GRect(0, 0, PBL_DISPLAY_WIDTH, PBL_DISPLAY_HEIGHT),
+    .fill_color = GColorBlack,
+    .stroke_color = GColorBlack,
+    .text_color = GColorBlack,
+    .compositing_mode = GCompOpAssign,
+  };
+  return &s_context;
+}
+
+void host_graphics_set_drawing_box(GContext *ctx, GPoint origin, GRect clip) {
+  ctx->offset = origin;
+  ctx->clip = host_grect_intersect(clip, GRect(0, 0, PBL_DISPLAY_WIDTH, PBL_DISPLAY_HEIGHT));
+}
+
+GBitmap *graphics_capture_frame_buffer(GContext *ctx) {
+  return ctx->frame;
+}
+
+bool graphics_release_frame_buffer(GContext *ctx, GBitmap *buffer) {
+  return buffer == ctx->frame;
+}
+
+void graphics_context_set_fill_color(GContext *ctx, GColor color) {
+  ctx->fill_color = color;
+}
+
+void graphics_context_set_stroke_color(GContext *ctx, GColor color) {
+  ctx->stroke_color = color;
+}
+
+void graphics_context_set_text_color(GContext *ctx, GColor color) {
+  ctx->text_color = color;
+}
+
+void graphics_context_set_compositing_mode(GContext *ctx, GCompOp mode) {
+  ctx->compositing_mode = mode;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Primitives, in layer coordinates
+
+// Transparent colours leave the pixel alone, there is no blending
+static void put_pixel(GContext *ctx, int x, int y, GColor color) {
+  x += ctx->offset.x;
+  y += ctx->offset.y;
+  if (color.a == 0 || x < ctx->clip.origin.x || y < ctx->clip.origin.y
+      || x >= ctx->clip.origin.x + ctx->clip.size.w || y >= ctx->clip.origin.y + ctx->clip.size.h) {
+    return;
+  }
+  ctx->frame->data[y * ctx->frame->row_size + x] = color.argb | 0xC0;
+}
+
+static void fill_area(GContext *ctx, int x, int y, int w, int h, GColor color) {
+  for (int py = y; py < y + h; py++) {
+    for (int px = x; px < x + w; px++) {
+      put_pixel(ctx, px, py, color);
+    }
+  }
+}
+
+// Outside the quarter circle of a rounded corner
+static bool outside_corner(GRect rect, int x, int y, int radius, GCornerMask corners) {
+  int left = x - rect.origin.x, top = y - rect.origin.y;
+  int right = rect.origin.x + rect.size.w - 1 - x, bottom = rect.origin.y + rect.size.h - 1 - y;
+  int dx = 0, dy = 0;
+  if (left < radius && top < radius && (corners & 1)) {
+    dx = radius - left;
+    dy = radius - top;
+  } else if (right < radius && top < radius && (corners & 2)) {
+    dx = radius - right;
+    dy = radius - top;
+  } else if (left < radius && bottom < radius && (corners & 4)) {
+    dx = radius - left;
+    dy = radius - bottom;
+  } else if (right < radius && bottom < radius && (corners & 8)) {
+    dx = radius - right;
+    dy = radius - bottom;
+  } else {
+    return false;
+  }
+  return dx * dx + dy * dy > radius * radius;
+}
+
+void graphics_fill_rect(GContext *ctx, GRect rect, uint16_t corner_radius, GCornerMask corner_mask) {
+  for (int y = rect.origin.y; y < rect.origin.y + rect.size.h; y++) {
+    for (int x = rect.origin.x; x < rect.origin.x + rect.size.w; x++) {
+      if (corner_radius == 0 || !outside_corner(rect, x, y, corner_radius, corner_mask)) {
+        put_pixel(ctx, x, y, ctx->fill_color);
+      }
+    }
+  }
+}
+
+void graphics_draw_rect(GContext *ctx, GRect rect) {
+  if (rect.size.w <= 0 || rect.size.h <= 0) {
+    return;
+  }
+  fill_area(ctx, rect.origin.x, rect.origin.y, rect.size.w, 1, ctx->stroke_color);
+  fill_area(ctx, rect.origin.x, rect.origin.y + rect.size.h - 1, rect.size.w, 1, ctx->stroke_color);
+  fill_area(ctx, rect.origin.x, rect.origin.y, 1, rect.size.h, ctx->stroke_color);
+  fill_area(ctx, rect.origin.x + rect.size.w - 1, rect.origin.y, 1, rect.size.h, ctx->stroke_color);
+}
+
+// Bresenham, one pixel wide
+void graphics_draw_line(GContext *ctx, GPoint p0, GPoint p1) {
+  int dx = abs(p1.x - p0.x), dy = -abs(p1.y - p0.y);
+  int sx = p0.x < p1.x ? 1 : -1, sy = p0.y < p1.y ? 1 : -1;
+  int error = dx + dy;
+  int x = p0.x, y = p0.y;
+  for (;;) {
+    put_pixel(ctx, x, y, ctx->stroke_color);
+    if (x == p1.x && y == p1.y) {
+      break;
+    }
+    int twice = 2 * error;
+    if (twice >= dy) {
+      error += dy;
+      x += sx;
+    }
+    if (twice <= dx) {
+      error += dx;
+      y += sy;
+    }
+  }
+}
+
+// Tiled when the rectangle is larger than the bitmap, as on the watch
+void graphics_draw_bitmap_in_rect(GContext *ctx, const GBitmap *bitmap, GRect rect) {
+  if (!bitmap || bitmap->bounds.size.w <= 0 || bitmap->bounds.size.h <= 0) {
+    return;
+  }
+  GCompOp mode = ctx->compositing_mode;
+  for (int dy = 0; dy < rect.size.h; dy++) {
+    int sy = bitmap->bounds.origin.y + dy % bitmap->bounds.size.h;
+    for (int dx = 0; dx < rect.size.w; dx++) {
+      int sx = bitmap->bounds.origin.x + dx % bitmap->bounds.size.w;
+      uint8_t index = bitmap_index(bitmap, sx, sy);
+      int x = rect.origin.x + dx, y = rect.origin.y + dy;
+
+      if (bitmap->format == GBitmapFormat1Bit) {
+        bool white = index != 0;
+        switch (mode) {
+          case GCompOpAssign:
+            put_pixel(ctx, x, y, white ? GColorWhite : GColorBlack);
+            break;
+          case GCompOpAssignInverted:
+            put_pixel(ctx, x, y, white ? GColorBlack : GColorWhite);
+            break;
+          case GCompOpAnd:
+            if (!white) {
+              put_pixel(ctx, x, y, GColorBlack);
+            }
+            break;
+          case GCompOpClear:
+            if (white) {
+              put_pixel(ctx, x, y, GColorBlack);
+            }
+            break;
+          default:
+            if (white) {
+              put_pixel(ctx, x, y, GColorWhite);
+            }
+            break;
+        }
+        continue;
+      }
+
+      GColor color = bitmap->format == GBitmapFormat8Bit ? (GColor) { .argb = index }
+                   : bitmap->palette ? bitmap->palette[index] : GColorBlack;
+      if (mode == GCompOpSet) {
+        put_pixel(ctx, x, y, color);
+      } else {
+        // Opacity is ignored when assigning
+        color.a = 3;
+        put_pixel(ctx, x, y, color);
+      }
+    }
+  }
+}
+
+// Menu and action bar icons: the black of 1-bit icons takes the colour
+void host_graphics_draw_icon(GContext *ctx, const GBitmap *bitmap, GRect rect, GColor color) {
+  if (!bitmap || bitmap->format != GBitmapFormat1Bit) {
+    GCompOp mode = ctx->compositing_mode;
+    ctx->compositing_mode = GCompOpSet;
+    graphics_draw_bitmap_in_rect(ctx, bitmap, rect);
+    ctx->compositing_mode = mode;
+    return;
+  }
+  for (int y = 0; y < rect.size.h && y < bitmap->bounds.size.h; y++) {
+    for (int x = 0; x < rect.size.w && x < bitmap->bounds.size.w; x++) {
+      if (bitmap_index(bitmap, bitmap->bounds.origin.x + x, bitmap->bounds.origin.y + y) == 0) {
+        put_pixel(ctx, rect.origin.x + x, rect.origin.y + y, color);
+      }
+    }
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Text
+
+typedef struct TextLine {
+  const char *start;
+  int length;
+} text_line_t;
+
+static int glyph_advance(GFont font) {
+  return (HOST_FONT_GLYPH_WIDTH + 1) * font->scale;
+}
+
+// Non-ASCII characters become '?', one per UTF-8 sequence
+static void to_ascii(const char *text, char *out, size_t size) {
+  size_t length = 0;
+  for (const unsigned char *c = (const unsigned char *)text; *c && length + 1 < size; c++) {
+    if (*c < 0x80) {
+      out[length++] = *c;
+    } else if (*c >= 0xC0) {
+      out[length++] = '?';
+    }
+  }
+  out[length] = '\0';
+}
+
+// Greedy word wrap on spaces, words wider than the box are cut
+static int layout_lines(const char *text, GFont font, GRect box, text_line_t lines[HOST_TEXT_MAX_LINES]) {
+  int columns = box.size.w / glyph_advance(font);
+  if (columns < 1) {
+    columns = 1;
+  }
+  int count = 0;
+  const char *c = text;
+  while (*c && count < HOST_TEXT_MAX_LINES) {
+    const char *end = c;
+    const char *last_space = NULL;
+    while (*end && *end != '\n' && end - c < columns) {
+      if (*end == ' ') {
+        last_space = end;
+      }
+      end++;
+    }
+    if (*end && *end != '\n' && *end != ' ' && last_space) {
+      end = last_space;
+    }
+    lines[count++] = (text_line_t) { c, end - c };
+    c = end;
+    if (*c == '\n' || *c == ' ') {
+      c++;
+    }
+  }
+  return count;
+}
+
+static void draw_glyph(GContext *ctx, char c, int x, int y, int scale, GColor color) {
+  if (c < HOST_FONT_FIRST_GLYPH || c >= HOST_FONT_FIRST_GLYPH + HOST_FONT_GLYPH_COUNT) {
+    c = '?';
+  }
+  const uint8_t *rows = host_font_glyphs[c - HOST_FONT_FIRST_GLYPH];
+  for (int row = 0; row < HOST_FONT_GLYPH_HEIGHT; row++) {
+    for (int column = 0; column < HOST_FONT_GLYPH_WIDTH; column++) {
+      if (rows[row] & (0x10 >> column)) {
+        fill_area(ctx, x + column * scale, y + row * scale, scale, scale, color);
+      }
+    }
+  }
+}
+
+void graphics_draw_text(GContext *ctx, const char *text, GFont font, GRect box, GTextOverflowMode overflow_mode,
+                        GTextAlignment alignment, void *layout) {
+  if (!text || !font) {
+    return;
+  }
+  char ascii[HOST_TEXT_MAX];
+  to_ascii(text, ascii, sizeof(ascii));
+  text_line_t lines[HOST_TEXT_MAX_LINES];
+  int count = layout_lines(ascii, font, box, lines);
+  int advance = glyph_advance(font);
+  int top = (font->height - HOST_FONT_GLYPH_HEIGHT * font->scale) / 2;
+
+  for (int i = 0; i < count; i++) {
+    int y = box.origin.y + i * font->height;
+    // Only whole lines, the first one always
+    if (i > 0 && y + font->height > box.origin.y + box.size.h) {
+      break;
+    }
+    int width = lines[i].length * advance;
+    int x = box.origin.x;
+    if (alignment == GTextAlignmentCenter) {
+      x += (box.size.w - width) / 2;
+    } else if (alignment == GTextAlignmentRight) {
+      x += box.size.w - width;
+    }
+    for (int j = 0; j < lines[i].length; j++) {
+      draw_glyph(ctx, lines[i].start[j], x + j * advance, y + top, font->scale, ctx->text_color);
+    }
+  }
+}
+
+GSize graphics_text_layout_get_content_size(const char *text, GFont font, GRect box, GTextOverflowMode overflow_mode,
+                                            GTextAlignment alignment) {
+  char ascii[HOST_TEXT_MAX];
+  to_ascii(text, ascii, sizeof(ascii));
+  text_line_t lines[HOST_TEXT_MAX_LINES];
+  int count = layout_lines(ascii, font, box, lines);
+  int width = 0;
+  for (int i = 0; i < count; i++) {
+    if (lines[i].length * glyph_advance(font) > width) {
+      width = lines[i].length * glyph_advance(font);
+    }
+  }
+  return GSize(width, count * font->height);
+}
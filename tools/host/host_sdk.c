@@ -0,0 +1,513 @@
+// Virtual clock, timers, event services, storage and the other non-UI parts
+// of the SDK stand-in.
+
+#include <math.h>
+#include <stdarg.h>
+#include "host.h"
+
+static HostHooks s_hooks;
+
+void host_set_hooks(HostHooks hooks) {
+  s_hooks = hooks;
+}
+
+void host_app_log(AppLogLevel level, const char *file, int line, const char *format, ...) {
+  char message[256];
+  va_list args;
+  va_start(args, format);
+  vsnprintf(message, sizeof(message), format, args);
+  va_end(args);
+  
+  if (s_hooks.log) {
+    s_hooks.log(level, message);
+  } else {
+    fprintf(stderr, "%s:%d %s\n", file, line, message);
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Clock, timers and ticks
+
+// Timers are handed out as ids, so cancelling one that already fired is
+// harmless as on the watch
+struct AppTimer {
+  uint32_t id;
+  uint64_t due;
+  AppTimerCallback callback;
+  void *data;
+  struct AppTimer *next;
+};
+
+static uint64_t s_now;
+static struct AppTimer *s_timers;
+static uint32_t s_next_timer_id = 1;
+
+static TimeUnits s_tick_units;
+static TickHandler s_tick_handler;
+static uint64_t s_next_tick;
+
+void host_clock_set(time_t start) {
+  s_now = (uint64_t)start * 1000;
+}
+
+uint64_t host_clock_now(void) {
+  return s_now;
+}
+
+time_t host_time(time_t *t) {
+  time_t now = s_now / 1000;
+  if (t) {
+    *t = now;
+  }
+  return now;
+}
+
+uint16_t time_ms(time_t *t, uint16_t *out_ms) {
+  uint16_t ms = s_now % 1000;
+  if (t) {
+    *t = s_now / 1000;
+  }
+  if (out_ms) {
+    *out_ms = ms;
+  }
+  return ms;
+}
+
+static struct AppTimer *find_timer(AppTimer *handle, struct AppTimer ***link) {
+  uint32_t id = (uint32_t)(uintptr_t)handle;
+  for (struct AppTimer **p = &s_timers; *p; p = &(*p)->next) {
+    if ((*p)->id == id) {
+      if (link) {
+        *link = p;
+      }
+      return *p;
+    }
+  }
+  return NULL;
+}
+
+// Kept sorted by due time, in registration order for equal times
+static void insert_timer(struct AppTimer *timer) {
+  struct AppTimer **p = &s_timers;
+  while (*p && (*p)->due <= timer->due) {
+    p = &(*p)->next;
+  }
+  timer->next = *p;
+  *p = timer;
+}
+
+AppTimer *app_timer_register(uint32_t timeout_ms, AppTimerCallback callback, void *callback_data) {
+  struct AppTimer *timer = calloc(1, sizeof(*timer));
+  timer->id = s_next_timer_id++;
+  timer->due = s_now + timeout_ms;
+  timer->callback = callback;
+  timer->data = callback_data;
+  insert_timer(timer);
+  return (AppTimer *)(uintptr_t)timer->id;
+}
+
+bool app_timer_reschedule(AppTimer *handle, uint32_t new_timeout_ms) {
+  struct AppTimer **link;
+  struct AppTimer *timer = find_timer(handle, &link);
+  if (!timer) {
+    return false;
+  }
+  *link = timer->next;
+  timer->due = s_now + new_timeout_ms;
+  insert_timer(timer);
+  return true;
+}
+
+void app_timer_cancel(AppTimer *handle) {
+  struct AppTimer **link;
+  struct AppTimer *timer = find_timer(handle, &link);
+  if (timer) {
+    *link = timer->next;
+    free(timer);
+  }
+}
+
+static uint64_t tick_period(TimeUnits units) {
+  if (units & SECOND_UNIT) {
+    return 1000;
+  }
+  if (units & MINUTE_UNIT) {
+    return 60 * 1000;
+  }
+  if (units & HOUR_UNIT) {
+    return 3600 * 1000;
+  }
+  return 86400 * 1000;
+}
+
+static uint64_t next_boundary(uint64_t now, TimeUnits units) {
+  uint64_t period = tick_period(units);
+  return (now / period + 1) * period;
+}
+
+void tick_timer_service_subscribe(TimeUnits tick_units, TickHandler handler) {
+  s_tick_units = tick_units;
+  s_tick_handler = handler;
+  s_next_tick = next_boundary(s_now, tick_units);
+}
+
+void tick_timer_service_unsubscribe(void) {
+  s_tick_handler = NULL;
+}
+
+static void fire_tick(void) {
+  time_t now = s_now / 1000;
+  struct tm *tick_time = gmtime(&now);
+  TimeUnits changed = SECOND_UNIT;
+  if (tick_time->tm_sec == 0) {
+    changed |= MINUTE_UNIT;
+    if (tick_time->tm_min == 0) {
+      changed |= HOUR_UNIT;
+      if (tick_time->tm_hour == 0) {
+        changed |= DAY_UNIT;
+      }
+    }
+  }
+  s_next_tick = next_boundary(s_now, s_tick_units);
+  s_tick_handler(tick_time, changed & ~(tick_period(s_tick_units) > 1000 ? SECOND_UNIT : 0));
+}
+
+void host_advance(uint32_t ms) {
+  uint64_t target = s_now + ms;
+  
+  for (;;) {
+    uint64_t next = target + 1;
+    bool timer = false;
+    if (s_timers && s_timers->due < next) {
+      next = s_timers->due;
+      timer = true;
+    }
+    if (s_tick_handler && s_next_tick < next) {
+      next = s_next_tick;
+      timer = false;
+    }
+    if (next > target) {
+      break;
+    }
+    
+    s_now = next > s_now ? next : s_now;
+    if (timer) {
+      struct AppTimer *due = s_timers;
+      s_timers = due->next;
+      AppTimerCallback callback = due->callback;
+      void *data = due->data;
+      free(due);
+      callback(data);
+    } else {
+      fire_tick();
+    }
+  }
+  s_now = target;
+}
+
+void app_event_loop(void) {
+  // The watch draws the top window as soon as the app enters its loop
+  host_render_frame();
+  if (s_hooks.event_loop) {
+    s_hooks.event_loop();
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Battery, vibes and backlight
+
+static BatteryChargeState s_battery = { .charge_percent = 100 };
+static BatteryStateHandler s_battery_handler;
+
+void battery_state_service_subscribe(BatteryStateHandler handler) {
+  s_battery_handler = handler;
+}
+
+BatteryChargeState battery_state_service_peek(void) {
+  return s_battery;
+}
+
+void host_set_battery(BatteryChargeState state) {
+  s_battery = state;
+  if (s_battery_handler) {
+    s_battery_handler(state);
+  }
+}
+
+void vibes_enqueue_custom_pattern(VibePattern pattern) {
+  if (s_hooks.vibe) {
+    s_hooks.vibe(&pattern);
+  }
+}
+
+void light_enable_interaction(void) {
+  if (s_hooks.light) {
+    s_hooks.light();
+  }
+}
+
+size_t heap_bytes_free(void) {
+  return 16 * 1024;
+}
+
+size_t heap_bytes_used(void) {
+  return 8 * 1024;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Geometry and trigonometry
+
+GRect grect_inset(GRect rect, GEdgeInsets insets) {
+  return GRect(rect.origin.x + insets.left, rect.origin.y + insets.top,
+               rect.size.w - insets.left - insets.right, rect.size.h - insets.top - insets.bottom);
+}
+
+int32_t sin_lookup(int32_t angle) {
+  return (int32_t)lround(sin(angle * 2 * M_PI / TRIG_MAX_ANGLE) * TRIG_MAX_RATIO);
+}
+
+int32_t cos_lookup(int32_t angle) {
+  return (int32_t)lround(cos(angle * 2 * M_PI / TRIG_MAX_ANGLE) * TRIG_MAX_RATIO);
+}
+
+int32_t atan2_lookup(int16_t y, int16_t x) {
+  double angle = atan2(y, x);
+  if (angle < 0) {
+    angle += 2 * M_PI;
+  }
+  return (int32_t)lround(angle * TRIG_MAX_ANGLE / (2 * M_PI)) % TRIG_MAX_ANGLE;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Persistent storage, in memory for the run
+
+#define HOST_PERSIST_SLOTS 256
+
+typedef struct PersistSlot {
+  uint32_t key;
+  bool used;
+  uint16_t length;
+  uint8_t data[PERSIST_DATA_MAX_LENGTH];
+} persist_slot_t;
+
+static persist_slot_t s_persist[HOST_PERSIST_SLOTS];
+
+static persist_slot_t *persist_slot(uint32_t key, bool create) {
+  persist_slot_t *free_slot = NULL;
+  for (int i = 0; i < HOST_PERSIST_SLOTS; i++) {
+    if (s_persist[i].used && s_persist[i].key == key) {
+      return &s_persist[i];
+    }
+    if (!s_persist[i].used && !free_slot) {
+      free_slot = &s_persist[i];
+    }
+  }
+  if (create && free_slot) {
+    free_slot->used = true;
+    free_slot->key = key;
+    return free_slot;
+  }
+  return NULL;
+}
+
+bool persist_exists(uint32_t key) {
+  return persist_slot(key, false) != NULL;
+}
+
+int persist_read_data(uint32_t key, void *buffer, size_t buffer_size) {
+  persist_slot_t *slot = persist_slot(key, false);
+  if (!slot) {
+    return -2; // E_DOES_NOT_EXIST
+  }
+  size_t length = slot->length < buffer_size ? slot->length : buffer_size;
+  memcpy(buffer, slot->data, length);
+  return length;
+}
+
+int persist_write_data(uint32_t key, const void *data, size_t size) {
+  persist_slot_t *slot = persist_slot(key, true);
+  if (!slot) {
+    return -3; // E_OUT_OF_STORAGE
+  }
+  slot->length = size < PERSIST_DATA_MAX_LENGTH ? size : PERSIST_DATA_MAX_LENGTH;
+  memcpy(slot->data, data, slot->length);
+  return slot->length;
+}
+
+bool persist_read_bool(uint32_t key) {
+  bool value = false;
+  persist_read_data(key, &value, sizeof(value));
+  return value;
+}
+
+int persist_write_bool(uint32_t key, bool value) {
+  return persist_write_data(key, &value, sizeof(value));
+}
+
+int persist_delete(uint32_t key) {
+  persist_slot_t *slot = persist_slot(key, false);
+  if (!slot) {
+    return -2; // E_DOES_NOT_EXIST
+  }
+  slot->used = false;
+  return 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Resources, read from the files listed in package.json
+
+static FILE *open_resource(ResHandle handle) {
+  if (handle == 0 || handle >= host_resource_count) {
+    return NULL;
+  }
+  return fopen(host_resource_files[handle], "rb");
+}
+
+ResHandle resource_get_handle(uint32_t resource_id) {
+  return resource_id;
+}
+
+size_t resource_size(ResHandle handle) {
+  FILE *file = open_resource(handle);
+  if (!file) {
+    return 0;
+  }
+  fseek(file, 0, SEEK_END);
+  size_t size = ftell(file);
+  fclose(file);
+  return size;
+}
+
+size_t resource_load_byte_range(ResHandle handle, uint32_t start_offset, uint8_t *buffer, size_t num_bytes) {
+  FILE *file = open_resource(handle);
+  if (!file) {
+    return 0;
+  }
+  fseek(file, start_offset, SEEK_SET);
+  size_t read = fread(buffer, 1, num_bytes, file);
+  fclose(file);
+  return read;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Data logging goes to the driver, the phone is never connected
+
+struct DataLoggingSession {
+  uint32_t tag;
+  uint16_t item_length;
+};
+
+DataLoggingSessionRef data_logging_create(uint32_t tag, DataLoggingItemType item_type, uint16_t item_length, bool resume) {
+  DataLoggingSessionRef session = calloc(1, sizeof(*session));
+  session->tag = tag;
+  session->item_length = item_length;
+  return session;
+}
+
+DataLoggingResult data_logging_log(DataLoggingSessionRef session, const void *data, uint32_t num_items) {
+  if (!session) {
+    return DATA_LOGGING_NOT_FOUND;
+  }
+  if (s_hooks.data_logging) {
+    s_hooks.data_logging(session->tag, data, num_items, session->item_length);
+  }
+  return DATA_LOGGING_SUCCESS;
+}
+
+void data_logging_finish(DataLoggingSessionRef session) {
+  free(session);
+}
+
+// App glance, handed to the driver once the reload is complete
+
+#define HOST_GLANCE_SLICES 8
+
+struct AppGlanceReloadSession {
+  AppGlanceSlice slices[HOST_GLANCE_SLICES];
+  size_t count;
+};
+
+void app_glance_reload(AppGlanceReloadCallback callback, void *context) {
+  AppGlanceReloadSession session = { .count = 0 };
+  if (callback) {
+    callback(&session, HOST_GLANCE_SLICES, context);
+  }
+  if (s_hooks.glance) {
+    s_hooks.glance(session.slices, session.count);
+  }
+}
+
+AppGlanceResult app_glance_add_slice(AppGlanceReloadSession *session, AppGlanceSlice slice) {
+  if (session->count == HOST_GLANCE_SLICES) {
+    return APP_GLANCE_RESULT_SLICE_CAPACITY_EXCEEDED;
+  }
+  if (slice.expiration_time != APP_GLANCE_SLICE_NO_EXPIRATION && slice.expiration_time <= host_time(NULL)) {
+    return APP_GLANCE_RESULT_EXPIRES_IN_THE_PAST;
+  }
+  session->slices[session->count++] = slice;
+  return APP_GLANCE_RESULT_SUCCESS;
+}
+
+AppMessageResult app_message_open(uint32_t size_inbound, uint32_t size_outbound) {
+  return APP_MSG_OK;
+}
+
+uint32_t app_message_inbox_size_maximum(void) {
+  return 8200;
+}
+
+uint32_t app_message_outbox_size_maximum(void) {
+  return 8200;
+}
+
+AppMessageResult app_message_outbox_begin(DictionaryIterator **iterator) {
+  *iterator = NULL;
+  return APP_MSG_NOT_CONNECTED;
+}
+
+AppMessageResult app_message_outbox_send(void) {
+  return APP_MSG_NOT_CONNECTED;
+}
+
+AppMessageInboxReceived app_message_register_inbox_received(AppMessageInboxReceived received_callback) {
+  return NULL;
+}
+
+AppMessageInboxDropped app_message_register_inbox_dropped(AppMessageInboxDropped dropped_callback) {
+  return NULL;
+}
+
+AppMessageOutboxSent app_message_register_outbox_sent(AppMessageOutboxSent sent_callback) {
+  return NULL;
+}
+
+AppMessageOutboxFailed app_message_register_outbox_failed(AppMessageOutboxFailed failed_callback) {
+  return NULL;
+}
+
+uint32_t dict_calc_buffer_size(const uint8_t tuple_count, ...) {
+  va_list args;
+  va_start(args, tuple_count);
+  uint32_t size = 1;
+  for (int i = 0; i < tuple_count; i++) {
+    size += 7 + va_arg(args, uint32_t);
+  }
+  va_end(args);
+  return size;
+}
+
+Tuple *dict_find(const DictionaryIterator *iter, const uint32_t key) {
+  return NULL;
+}
+
+DictionaryResult dict_write_data(DictionaryIterator *iter, const uint32_t key, const uint8_t *data, const uint16_t size) {
+  return DICT_INVALID_ARGS;
+}
+
+DictionaryResult dict_write_uint8(DictionaryIterator *iter, const uint32_t key, const uint8_t value) {
+  return DICT_INVALID_ARGS;
+}
+
+DictionaryResult dict_write_uint16(DictionaryIterator *iter, const uint32_t key, const uint16_t value) {
+  return DICT_INVALID_ARGS;
+}
@@ -0,0 +1,829 @@
+// Window stack, layer tree, click dispatch and the built-in layers of the SDK
+// stand-in
+
+#include "host_ui.h"
+
+#define HOST_REPEAT_DELAY_MS 500
+#define HOST_CLICK_MS 100
+
+static Window *s_stack[HOST_WINDOW_STACK_SIZE];
+static uint8_t s_depth;
+static Window *s_configuring;
+
+struct ClickRecognizer {
+  ButtonId button;
+  uint8_t clicks;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// Layers
+
+Layer *layer_create_with_data(GRect frame, size_t data_size) {
+  Layer *layer = calloc(1, sizeof(Layer) + data_size);
+  layer->frame = frame;
+  layer->bounds = GRect(0, 0, frame.size.w, frame.size.h);
+  layer->clips = true;
+  layer->data = data_size > 0 ? layer + 1 : NULL;
+  return layer;
+}
+
+Layer *layer_create(GRect frame) {
+  return layer_create_with_data(frame, 0);
+}
+
+static void layer_remove_from_parent(Layer *layer) {
+  if (!layer->parent) {
+    return;
+  }
+  for (Layer **p = &layer->parent->first_child; *p; p = &(*p)->next_sibling) {
+    if (*p == layer) {
+      *p = layer->next_sibling;
+      break;
+    }
+  }
+  layer->parent = NULL;
+  layer->next_sibling = NULL;
+}
+
+void layer_destroy(Layer *layer) {
+  if (!layer) {
+    return;
+  }
+  layer_remove_from_parent(layer);
+  for (Layer *child = layer->first_child; child; ) {
+    Layer *next = child->next_sibling;
+    child->parent = NULL;
+    child->next_sibling = NULL;
+    child = next;
+  }
+  free(layer);
+}
+
+void *layer_get_data(const Layer *layer) {
+  return layer->data;
+}
+
+void layer_set_update_proc(Layer *layer, LayerUpdateProc update_proc) {
+  layer->update_proc = update_proc;
+}
+
+// Children are drawn in the order they were added, the last one on top
+void layer_add_child(Layer *parent, Layer *child) {
+  layer_remove_from_parent(child);
+  child->parent = parent;
+  Layer **p = &parent->first_child;
+  while (*p) {
+    p = &(*p)->next_sibling;
+  }
+  *p = child;
+}
+
+// Every frame redraws the whole window
+void layer_mark_dirty(Layer *layer) {
+}
+
+GRect layer_get_bounds(const Layer *layer) {
+  return layer->bounds;
+}
+
+GRect layer_get_frame(const Layer *layer) {
+  return layer->frame;
+}
+
+void layer_set_frame(Layer *layer, GRect frame) {
+  layer->frame = frame;
+  layer->bounds.size = frame.size;
+}
+
+void layer_set_hidden(Layer *layer, bool hidden) {
+  layer->hidden = hidden;
+}
+
+void layer_set_clips(Layer *layer, bool clips) {
+  layer->clips = clips;
+}
+
+Window *layer_get_window(const Layer *layer) {
+  while (layer->parent) {
+    layer = layer->parent;
+  }
+  return layer->window;
+}
+
+GPoint layer_convert_point_to_screen(const Layer *layer, GPoint point) {
+  for (; layer; layer = layer->parent) {
+    point.x += layer->frame.origin.x + layer->bounds.origin.x;
+    point.y += layer->frame.origin.y + layer->bounds.origin.y;
+  }
+  return point;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Windows and the window stack
+
+Window *window_create(void) {
+  Window *window = calloc(1, sizeof(Window));
+  window->root = layer_create(GRect(0, 0, PBL_DISPLAY_WIDTH, PBL_DISPLAY_HEIGHT));
+  window->root->window = window;
+  window->background = GColorWhite;
+  return window;
+}
+
+void window_destroy(Window *window) {
+  if (!window) {
+    return;
+  }
+  window_stack_remove(window, false);
+  layer_destroy(window->root);
+  free(window);
+}
+
+void window_set_window_handlers(Window *window, WindowHandlers handlers) {
+  window->handlers = handlers;
+}
+
+void window_set_background_color(Window *window, GColor color) {
+  window->background = color;
+}
+
+Layer *window_get_root_layer(const Window *window) {
+  return window->root;
+}
+
+static void configure_clicks(Window *window) {
+  memset(window->clicks, 0, sizeof(window->clicks));
+  void *context = window->click_context ? window->click_context : window;
+  for (int button = 0; button < NUM_BUTTONS; button++) {
+    window->clicks[button].context = context;
+  }
+  if (window->click_provider) {
+    s_configuring = window;
+    window->click_provider(context);
+    s_configuring = NULL;
+  }
+}
+
+void window_set_click_config_provider_with_context(Window *window, ClickConfigProvider provider, void *context) {
+  window->click_provider = provider;
+  window->click_context = context;
+  if (host_top_window() == window) {
+    configure_clicks(window);
+  }
+}
+
+void window_set_click_config_provider(Window *window, ClickConfigProvider provider) {
+  window_set_click_config_provider_with_context(window, provider, NULL);
+}
+
+void window_set_click_context(ButtonId button, void *context) {
+  if (s_configuring) {
+    s_configuring->clicks[button].context = context;
+  }
+}
+
+void window_single_click_subscribe(ButtonId button, ClickHandler handler) {
+  if (s_configuring) {
+    s_configuring->clicks[button].single = handler;
+  }
+}
+
+void window_single_repeating_click_subscribe(ButtonId button, uint16_t repeat_interval_ms, ClickHandler handler) {
+  if (s_configuring) {
+    s_configuring->clicks[button].single = handler;
+    s_configuring->clicks[button].repeat_interval_ms = repeat_interval_ms;
+  }
+}
+
+void window_long_click_subscribe(ButtonId button, uint16_t delay_ms, ClickHandler down_handler, ClickHandler up_handler) {
+  if (s_configuring) {
+    click_config_t *config = &s_configuring->clicks[button];
+    config->long_down = down_handler;
+    config->long_up = up_handler;
+    config->long_delay_ms = delay_ms ? delay_ms : 500;
+  }
+}
+
+void window_raw_click_subscribe(ButtonId button, ClickHandler down_handler, ClickHandler up_handler, void *context) {
+  if (s_configuring) {
+    click_config_t *config = &s_configuring->clicks[button];
+    config->raw_down = down_handler;
+    config->raw_up = up_handler;
+    config->raw_context = context;
+  }
+}
+
+uint8_t click_number_of_clicks_counted(ClickRecognizerRef recognizer) {
+  return recognizer->clicks;
+}
+
+ButtonId click_recognizer_get_button_id(ClickRecognizerRef recognizer) {
+  return recognizer->button;
+}
+
+Window *host_top_window(void) {
+  return s_depth > 0 ? s_stack[s_depth - 1] : NULL;
+}
+
+uint8_t host_window_stack(Window *windows[HOST_WINDOW_STACK_SIZE]) {
+  memcpy(windows, s_stack, s_depth * sizeof(Window *));
+  return s_depth;
+}
+
+bool window_stack_contains_window(Window *window) {
+  for (int i = 0; i < s_depth; i++) {
+    if (s_stack[i] == window) {
+      return true;
+    }
+  }
+  return false;
+}
+
+static void show(Window *window) {
+  configure_clicks(window);
+  if (window->handlers.appear) {
+    window->handlers.appear(window);
+  }
+}
+
+static void hide(Window *window) {
+  if (window->handlers.disappear) {
+    window->handlers.disappear(window);
+  }
+}
+
+static void unload(Window *window) {
+  if (window->handlers.unload) {
+    window->handlers.unload(window);
+  }
+  window->loaded = false;
+}
+
+void window_stack_push(Window *window, bool animated) {
+  if (window_stack_contains_window(window)) {
+    window_stack_remove(window, false);
+  }
+  if (s_depth == HOST_WINDOW_STACK_SIZE) {
+    return;
+  }
+  
+  Window *previous = host_top_window();
+  s_stack[s_depth++] = window;
+  if (!window->loaded) {
+    window->loaded = true;
+    if (window->handlers.load) {
+      window->handlers.load(window);
+    }
+  }
+  if (previous) {
+    hide(previous);
+  }
+  show(window);
+}
+
+bool window_stack_remove(Window *window, bool animated) {
+  int index = -1;
+  for (int i = 0; i < s_depth; i++) {
+    if (s_stack[i] == window) {
+      index = i;
+    }
+  }
+  if (index < 0) {
+    return false;
+  }
+  
+  bool was_top = index == s_depth - 1;
+  if (was_top) {
+    hide(window);
+  }
+  memmove(&s_stack[index], &s_stack[index + 1], (s_depth - index - 1) * sizeof(Window *));
+  s_depth--;
+  unload(window);
+  if (was_top && host_top_window()) {
+    show(host_top_window());
+  }
+  return true;
+}
+
+Window *window_stack_pop(bool animated) {
+  Window *window = host_top_window();
+  if (window) {
+    window_stack_remove(window, animated);
+  }
+  return window;
+}
+
+void window_stack_pop_all(bool animated) {
+  while (s_depth > 0) {
+    window_stack_pop(false);
+  }
+}
+
+Window *window_stack_get_top_window(void) {
+  return host_top_window();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Clicks
+
+void host_click(ButtonId button, uint32_t hold_ms) {
+  Window *window = host_top_window();
+  if (!window) {
+    return;
+  }
+  // The handlers may change the top window, the press still belongs to this one
+  click_config_t config = window->clicks[button];
+  struct ClickRecognizer recognizer = { .button = button, .clicks = 1 };
+  
+  if (config.raw_down) {
+    config.raw_down(&recognizer, config.raw_context);
+  }
+  
+  if (hold_ms >= config.long_delay_ms && config.long_down) {
+    host_advance(config.long_delay_ms);
+    config.long_down(&recognizer, config.context);
+    host_advance(hold_ms - config.long_delay_ms);
+    if (config.long_up) {
+      config.long_up(&recognizer, config.context);
+    }
+  } else if (config.single && config.repeat_interval_ms && hold_ms > HOST_REPEAT_DELAY_MS) {
+    config.single(&recognizer, config.context);
+    host_advance(HOST_REPEAT_DELAY_MS);
+    for (uint32_t held = HOST_REPEAT_DELAY_MS; held < hold_ms; held += config.repeat_interval_ms) {
+      recognizer.clicks++;
+      config.single(&recognizer, config.context);
+      host_advance(config.repeat_interval_ms);
+    }
+  } else if (button == BUTTON_ID_BACK && hold_ms >= 500 && !config.long_down) {
+    // Holding back leaves the app
+    window_stack_pop_all(true);
+  } else {
+    host_advance(hold_ms ? hold_ms : HOST_CLICK_MS);
+    if (config.single) {
+      config.single(&recognizer, config.context);
+    } else if (button == BUTTON_ID_BACK) {
+      window_stack_pop(true);
+    }
+  }
+  
+  if (config.raw_up) {
+    config.raw_up(&recognizer, config.raw_context);
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Text, bitmap, action bar and status bar layers
+
+static void text_layer_draw(Layer *layer, GContext *ctx) {
+  TextLayer *text_layer = *(TextLayer **)layer_get_data(layer);
+  GRect bounds = layer_get_bounds(layer);
+  graphics_context_set_fill_color(ctx, text_layer->background_color);
+  graphics_fill_rect(ctx, bounds, 0, GCornerNone);
+  if (text_layer->text) {
+    graphics_context_set_text_color(ctx, text_layer->text_color);
+    graphics_draw_text(ctx, text_layer->text, text_layer->font, bounds, text_layer->overflow_mode,
+                       text_layer->alignment, NULL);
+  }
+}
+
+TextLayer *text_layer_create(GRect frame) {
+  TextLayer *text_layer = calloc(1, sizeof(TextLayer));
+  text_layer->layer = layer_create_with_data(frame, sizeof(TextLayer *));
+  *(TextLayer **)layer_get_data(text_layer->layer) = text_layer;
+  layer_set_update_proc(text_layer->layer, text_layer_draw);
+  text_layer->text_color = GColorBlack;
+  text_layer->background_color = GColorWhite;
+  text_layer->font = fonts_get_system_font(FONT_KEY_GOTHIC_14);
+  text_layer->overflow_mode = GTextOverflowModeWordWrap;
+  return text_layer;
+}
+
+void text_layer_destroy(TextLayer *text_layer) {
+  layer_destroy(text_layer->layer);
+  free(text_layer);
+}
+
+Layer *text_layer_get_layer(TextLayer *text_layer) {
+  return text_layer->layer;
+}
+
+void text_layer_set_text(TextLayer *text_layer, const char *text) {
+  text_layer->text = text;
+}
+
+void text_layer_set_font(TextLayer *text_layer, GFont font) {
+  text_layer->font = font;
+}
+
+void text_layer_set_text_color(TextLayer *text_layer, GColor color) {
+  text_layer->text_color = color;
+}
+
+void text_layer_set_background_color(TextLayer *text_layer, GColor color) {
+  text_layer->background_color = color;
+}
+
+void text_layer_set_text_alignment(TextLayer *text_layer, GTextAlignment alignment) {
+  text_layer->alignment = alignment;
+}
+
+static void bitmap_layer_draw(Layer *layer, GContext *ctx) {
+  BitmapLayer *bitmap_layer = *(BitmapLayer **)layer_get_data(layer);
+  if (!bitmap_layer->bitmap) {
+    return;
+  }
+  GRect bounds = layer_get_bounds(layer);
+  GSize size = gbitmap_get_bounds(bitmap_layer->bitmap).size;
+  graphics_context_set_compositing_mode(ctx, bitmap_layer->compositing_mode);
+  graphics_draw_bitmap_in_rect(ctx, bitmap_layer->bitmap,
+                               GRect((bounds.size.w - size.w) / 2, (bounds.size.h - size.h) / 2, size.w, size.h));
+  graphics_context_set_compositing_mode(ctx, GCompOpAssign);
+}
+
+BitmapLayer *bitmap_layer_create(GRect frame) {
+  BitmapLayer *bitmap_layer = calloc(1, sizeof(BitmapLayer));
+  bitmap_layer->layer = layer_create_with_data(frame, sizeof(BitmapLayer *));
+  *(BitmapLayer **)layer_get_data(bitmap_layer->layer) = bitmap_layer;
+  layer_set_update_proc(bitmap_layer->layer, bitmap_layer_draw);
+  return bitmap_layer;
+}
+
+void bitmap_layer_destroy(BitmapLayer *bitmap_layer) {
+  layer_destroy(bitmap_layer->layer);
+  free(bitmap_layer);
+}
+
+Layer *bitmap_layer_get_layer(const BitmapLayer *bitmap_layer) {
+  return bitmap_layer->layer;
+}
+
+void bitmap_layer_set_bitmap(BitmapLayer *bitmap_layer, const GBitmap *bitmap) {
+  bitmap_layer->bitmap = bitmap;
+}
+
+void bitmap_layer_set_compositing_mode(BitmapLayer *bitmap_layer, GCompOp mode) {
+  bitmap_layer->compositing_mode = mode;
+}
+
+static void action_bar_layer_draw(Layer *layer, GContext *ctx) {
+  ActionBarLayer *action_bar = *(ActionBarLayer **)layer_get_data(layer);
+  GRect bounds = layer_get_bounds(layer);
+  graphics_context_set_fill_color(ctx, GColorBlack);
+  graphics_fill_rect(ctx, bounds, 0, GCornerNone);
+  static const int8_t offsets[NUM_BUTTONS] = { [BUTTON_ID_UP] = -50, [BUTTON_ID_DOWN] = 50 };
+  for (int button = BUTTON_ID_UP; button < NUM_BUTTONS; button++) {
+    const GBitmap *icon = action_bar->icons[button];
+    if (icon) {
+      GSize size = gbitmap_get_bounds(icon).size;
+      host_graphics_draw_icon(ctx, icon, GRect((bounds.size.w - size.w) / 2,
+                                               (bounds.size.h - size.h) / 2 + offsets[button], size.w, size.h),
+                              GColorWhite);
+    }
+  }
+}
+
+ActionBarLayer *action_bar_layer_create(void) {
+  ActionBarLayer *action_bar = calloc(1, sizeof(ActionBarLayer));
+  action_bar->layer = layer_create_with_data(GRect(PBL_DISPLAY_WIDTH - ACTION_BAR_WIDTH, 0, ACTION_BAR_WIDTH, PBL_DISPLAY_HEIGHT),
+                                             sizeof(ActionBarLayer *));
+  *(ActionBarLayer **)layer_get_data(action_bar->layer) = action_bar;
+  layer_set_update_proc(action_bar->layer, action_bar_layer_draw);
+  return action_bar;
+}
+
+void action_bar_layer_destroy(ActionBarLayer *action_bar) {
+  layer_destroy(action_bar->layer);
+  free(action_bar);
+}
+
+void action_bar_layer_set_icon(ActionBarLayer *action_bar, ButtonId button, const GBitmap *icon) {
+  action_bar->icons[button] = icon;
+}
+
+void action_bar_layer_add_to_window(ActionBarLayer *action_bar, Window *window) {
+  action_bar->window = window;
+  layer_add_child(window_get_root_layer(window), action_bar->layer);
+  if (action_bar->click_provider) {
+    window_set_click_config_provider(window, action_bar->click_provider);
+  }
+}
+
+void action_bar_layer_set_click_config_provider(ActionBarLayer *action_bar, ClickConfigProvider provider) {
+  action_bar->click_provider = provider;
+  if (action_bar->window) {
+    window_set_click_config_provider(action_bar->window, provider);
+  }
+}
+
+static void status_bar_layer_draw(Layer *layer, GContext *ctx) {
+  StatusBarLayer *status_bar = *(StatusBarLayer **)layer_get_data(layer);
+  GRect bounds = layer_get_bounds(layer);
+  graphics_context_set_fill_color(ctx, status_bar->background);
+  graphics_fill_rect(ctx, bounds, 0, GCornerNone);
+  
+  char text[8];
+  time_t now = time(NULL);
+  strftime(text, sizeof(text), "%H:%M", gmtime(&now));
+  graphics_context_set_text_color(ctx, status_bar->foreground);
+  graphics_draw_text(ctx, text, fonts_get_system_font(FONT_KEY_GOTHIC_14), bounds, GTextOverflowModeFill,
+                     GTextAlignmentCenter, NULL);
+}
+
+StatusBarLayer *status_bar_layer_create(void) {
+  StatusBarLayer *status_bar = calloc(1, sizeof(StatusBarLayer));
+  status_bar->layer = layer_create_with_data(GRect(0, 0, PBL_DISPLAY_WIDTH, STATUS_BAR_LAYER_HEIGHT), sizeof(StatusBarLayer *));
+  *(StatusBarLayer **)layer_get_data(status_bar->layer) = status_bar;
+  layer_set_update_proc(status_bar->layer, status_bar_layer_draw);
+  status_bar->background = GColorBlack;
+  status_bar->foreground = GColorWhite;
+  return status_bar;
+}
+
+void status_bar_layer_destroy(StatusBarLayer *status_bar) {
+  layer_destroy(status_bar->layer);
+  free(status_bar);
+}
+
+Layer *status_bar_layer_get_layer(StatusBarLayer *status_bar) {
+  return status_bar->layer;
+}
+
+void status_bar_layer_set_colors(StatusBarLayer *status_bar, GColor background, GColor foreground) {
+  status_bar->background = background;
+  status_bar->foreground = foreground;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Menu layer: Up and Down move the selection, Select calls back
+
+static uint16_t menu_sections(MenuLayer *menu) {
+  return menu->callbacks.get_num_sections ? menu->callbacks.get_num_sections(menu, menu->context) : 1;
+}
+
+static uint16_t menu_rows(MenuLayer *menu, uint16_t section) {
+  return menu->callbacks.get_num_rows ? menu->callbacks.get_num_rows(menu, section, menu->context) : 0;
+}
+
+static void menu_up_handler(ClickRecognizerRef recognizer, void *context) {
+  menu_layer_set_selected_next((MenuLayer *)context, true, MenuRowAlignCenter, true);
+}
+
+static void menu_down_handler(ClickRecognizerRef recognizer, void *context) {
+  menu_layer_set_selected_next((MenuLayer *)context, false, MenuRowAlignCenter, true);
+}
+
+static void menu_select_handler(ClickRecognizerRef recognizer, void *context) {
+  MenuLayer *menu = context;
+  if (menu->callbacks.select_click) {
+    MenuIndex index = menu->selected;
+    menu->callbacks.select_click(menu, &index, menu->context);
+  }
+}
+
+static void menu_select_long_handler(ClickRecognizerRef recognizer, void *context) {
+  MenuLayer *menu = context;
+  if (menu->callbacks.select_long_click) {
+    MenuIndex index = menu->selected;
+    menu->callbacks.select_long_click(menu, &index, menu->context);
+  }
+}
+
+static void menu_click_config_provider(void *context) {
+  window_single_repeating_click_subscribe(BUTTON_ID_UP, 100, menu_up_handler);
+  window_single_repeating_click_subscribe(BUTTON_ID_DOWN, 100, menu_down_handler);
+  window_single_click_subscribe(BUTTON_ID_SELECT, menu_select_handler);
+  window_long_click_subscribe(BUTTON_ID_SELECT, 0, menu_select_long_handler, NULL);
+}
+
+static int16_t menu_cell_height(MenuLayer *menu, MenuIndex index) {
+  return menu->callbacks.get_cell_height ? menu->callbacks.get_cell_height(menu, &index, menu->context) : 44;
+}
+
+static int16_t menu_header_height(MenuLayer *menu, uint16_t section) {
+  return menu->callbacks.get_header_height ? menu->callbacks.get_header_height(menu, section, menu->context) : 0;
+}
+
+// Draws one cell as its own layer below the menu, y in menu coordinates
+static void menu_draw_cell(MenuLayer *menu, GContext *ctx, GPoint origin, GRect clip, int16_t y, int16_t height,
+                           GColor background, GColor foreground, MenuIndex *index, uint16_t section) {
+  GRect bounds = layer_get_bounds(menu->layer);
+  Layer cell = {
+    .frame = GRect(0, y, bounds.size.w, height),
+    .bounds = GRect(0, 0, bounds.size.w, height),
+    .clips = true,
+    .parent = menu->layer,
+  };
+  GRect cell_clip = host_grect_intersect(clip, GRect(origin.x, origin.y + y, bounds.size.w, height));
+  if (cell_clip.size.h == 0) {
+    return;
+  }
+  host_graphics_set_drawing_box(ctx, GPoint(origin.x, origin.y + y), cell_clip);
+  graphics_context_set_fill_color(ctx, background);
+  graphics_fill_rect(ctx, cell.bounds, 0, GCornerNone);
+  graphics_context_set_text_color(ctx, foreground);
+  if (index && menu->callbacks.draw_row) {
+    menu->callbacks.draw_row(ctx, &cell, index, menu->context);
+  } else if (!index && menu->callbacks.draw_header) {
+    menu->callbacks.draw_header(ctx, &cell, section, menu->context);
+  }
+}
+
+// The selected row is kept centered, within the ends of the list
+static void menu_layer_draw(Layer *layer, GContext *ctx) {
+  MenuLayer *menu = *(MenuLayer **)layer_get_data(layer);
+  GRect bounds = layer_get_bounds(layer);
+  GPoint origin = ctx->offset;
+  GRect clip = ctx->clip;
+  graphics_context_set_fill_color(ctx, menu->normal_background);
+  graphics_fill_rect(ctx, bounds, 0, GCornerNone);
+  
+  int16_t total = 0, selected_center = 0;
+  uint16_t sections = menu_sections(menu);
+  for (uint16_t section = 0; section < sections; section++) {
+    total += menu_header_height(menu, section);
+    for (uint16_t row = 0; row < menu_rows(menu, section); row++) {
+      int16_t height = menu_cell_height(menu, (MenuIndex) { section, row });
+      if (section == menu->selected.section && row == menu->selected.row) {
+        selected_center = total + height / 2;
+      }
+      total += height;
+    }
+  }
+  int16_t scroll = selected_center - bounds.size.h / 2;
+  if (scroll > total - bounds.size.h) {
+    scroll = total - bounds.size.h;
+  }
+  if (scroll < 0) {
+    scroll = 0;
+  }
+  
+  int16_t y = -scroll;
+  for (uint16_t section = 0; section < sections; section++) {
+    int16_t header = menu_header_height(menu, section);
+    if (header > 0) {
+      menu_draw_cell(menu, ctx, origin, clip, y, header, menu->normal_background, menu->normal_foreground, NULL, section);
+    }
+    y += header;
+    for (uint16_t row = 0; row < menu_rows(menu, section) && y < bounds.size.h; row++) {
+      MenuIndex index = { section, row };
+      int16_t height = menu_cell_height(menu, index);
+      bool highlighted = section == menu->selected.section && row == menu->selected.row;
+      menu_draw_cell(menu, ctx, origin, clip, y, height,
+                     highlighted ? menu->highlight_background : menu->normal_background,
+                     highlighted ? menu->highlight_foreground : menu->normal_foreground, &index, section);
+      y += height;
+    }
+  }
+  host_graphics_set_drawing_box(ctx, origin, clip);
+}
+
+// Icon on the left, title over the subtitle
+void menu_cell_basic_draw(GContext *ctx, const Layer *cell_layer, const char *title, const char *subtitle, GBitmap *icon) {
+  GRect bounds = layer_get_bounds(cell_layer);
+  int16_t x = 5;
+  if (icon) {
+    GSize size = gbitmap_get_bounds(icon).size;
+    host_graphics_draw_icon(ctx, icon, GRect(x, (bounds.size.h - size.h) / 2, size.w, size.h), ctx->text_color);
+    x += size.w + 5;
+  }
+  GFont title_font = fonts_get_system_font(FONT_KEY_GOTHIC_24_BOLD);
+  int16_t title_y = subtitle ? 0 : (bounds.size.h - 24) / 2;
+  if (title) {
+    graphics_draw_text(ctx, title, title_font, GRect(x, title_y, bounds.size.w - x, 24), GTextOverflowModeTrailingEllipsis,
+                       GTextAlignmentLeft, NULL);
+  }
+  if (subtitle) {
+    graphics_draw_text(ctx, subtitle, fonts_get_system_font(FONT_KEY_GOTHIC_18), GRect(x, 22, bounds.size.w - x, 18),
+                       GTextOverflowModeTrailingEllipsis, GTextAlignmentLeft, NULL);
+  }
+}
+
+void menu_cell_basic_header_draw(GContext *ctx, const Layer *cell_layer, const char *title) {
+  GRect bounds = layer_get_bounds(cell_layer);
+  if (title) {
+    graphics_draw_text(ctx, title, fonts_get_system_font(FONT_KEY_GOTHIC_14), GRect(2, 0, bounds.size.w - 4, bounds.size.h),
+                       GTextOverflowModeTrailingEllipsis, GTextAlignmentLeft, NULL);
+  }
+}
+
+MenuLayer *menu_layer_create(GRect frame) {
+  MenuLayer *menu = calloc(1, sizeof(MenuLayer));
+  menu->layer = layer_create_with_data(frame, sizeof(MenuLayer *));
+  *(MenuLayer **)layer_get_data(menu->layer) = menu;
+  layer_set_update_proc(menu->layer, menu_layer_draw);
+  menu->normal_background = GColorWhite;
+  menu->normal_foreground = GColorBlack;
+  menu->highlight_background = GColorBlack;
+  menu->highlight_foreground = GColorWhite;
+  return menu;
+}
+
+void menu_layer_destroy(MenuLayer *menu) {
+  layer_destroy(menu->layer);
+  free(menu);
+}
+
+Layer *menu_layer_get_layer(const MenuLayer *menu) {
+  return menu->layer;
+}
+
+void menu_layer_set_callbacks(MenuLayer *menu, void *context, MenuLayerCallbacks callbacks) {
+  menu->callbacks = callbacks;
+  menu->context = context;
+}
+
+void menu_layer_set_click_config_onto_window(MenuLayer *menu, Window *window) {
+  window_set_click_config_provider_with_context(window, menu_click_config_provider, menu);
+}
+
+void menu_layer_set_normal_colors(MenuLayer *menu, GColor background, GColor foreground) {
+  menu->normal_background = background;
+  menu->normal_foreground = foreground;
+}
+
+void menu_layer_set_highlight_colors(MenuLayer *menu, GColor background, GColor foreground) {
+  menu->highlight_background = background;
+  menu->highlight_foreground = foreground;
+}
+
+void menu_layer_reload_data(MenuLayer *menu) {
+  uint16_t sections = menu_sections(menu);
+  if (menu->selected.section >= sections) {
+    menu->selected = (MenuIndex) { 0, 0 };
+  }
+  uint16_t rows = menu_rows(menu, menu->selected.section);
+  if (menu->selected.row >= rows) {
+    menu->selected.row = rows > 0 ? rows - 1 : 0;
+  }
+}
+
+void menu_layer_set_selected_index(MenuLayer *menu, MenuIndex index, MenuRowAlign align, bool animated) {
+  menu->selected = index;
+  menu_layer_reload_data(menu);
+}
+
+void menu_layer_set_selected_next(MenuLayer *menu, bool up, MenuRowAlign align, bool animated) {
+  MenuIndex index = menu->selected;
+  if (up) {
+    if (index.row > 0) {
+      index.row--;
+    } else if (index.section > 0) {
+      index.section--;
+      uint16_t rows = menu_rows(menu, index.section);
+      index.row = rows > 0 ? rows - 1 : 0;
+    }
+  } else {
+    if (index.row + 1 < menu_rows(menu, index.section)) {
+      index.row++;
+    } else if (index.section + 1 < menu_sections(menu)) {
+      index.section++;
+      index.row = 0;
+    }
+  }
+  menu->selected = index;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Frames
+
+static void render_layer(GContext *ctx, Layer *layer, GPoint parent_origin, GRect parent_clip) {
+  if (layer->hidden) {
+    return;
+  }
+  GPoint origin = GPoint(parent_origin.x + layer->frame.origin.x, parent_origin.y + layer->frame.origin.y);
+  GRect clip = parent_clip;
+  if (layer->clips) {
+    clip = host_grect_intersect(clip, GRect(origin.x, origin.y, layer->frame.size.w, layer->frame.size.h));
+  }
+  GPoint drawing_origin = GPoint(origin.x + layer->bounds.origin.x, origin.y + layer->bounds.origin.y);
+  if (layer->update_proc) {
+    host_graphics_set_drawing_box(ctx, drawing_origin, clip);
+    layer->update_proc(layer, ctx);
+  }
+  for (Layer *child = layer->first_child; child; child = child->next_sibling) {
+    render_layer(ctx, child, drawing_origin, clip);
+  }
+}
+
+// Only the top window shows, the ones below are covered
+const GBitmap *host_render_frame(void) {
+  GContext *ctx = host_graphics_context();
+  Window *window = host_top_window();
+  graphics_context_set_fill_color(ctx, window ? window->background : GColorBlack);
+  graphics_fill_rect(ctx, GRect(0, 0, PBL_DISPLAY_WIDTH, PBL_DISPLAY_HEIGHT), 0, GCornerNone);
+  if (window) {
+    render_layer(ctx, window->root, GPointZero, GRect(0, 0, PBL_DISPLAY_WIDTH, PBL_DISPLAY_HEIGHT));
+  }
+#if defined(PBL_ROUND)
+  // What falls outside the circle is not on the glass
+  for (int y = 0; y < PBL_DISPLAY_HEIGHT; y++) {
+    uint8_t *row = gbitmap_get_data_row_info(ctx->frame, y).data;
+    for (int x = 0; x < PBL_DISPLAY_WIDTH; x++) {
+      int dx = 2 * x + 1 - PBL_DISPLAY_WIDTH, dy = 2 * y + 1 - PBL_DISPLAY_HEIGHT;
+      if (dx * dx + dy * dy > PBL_DISPLAY_WIDTH * PBL_DISPLAY_WIDTH) {
+        row[x] = GColorBlack.argb;
+      }
+    }
+  }
+#endif
+  return ctx->frame;
+}
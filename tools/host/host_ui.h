@@ -0,0 +1,123 @@
+#pragma once
+
+// Internals of the windows and layers shared by the host UI and graphics
+#include "host.h"
+
+#define HOST_WINDOW_STACK_SIZE 16
+
+#define HOST_FONT_FIRST_GLYPH ' '
+#define HOST_FONT_GLYPH_COUNT 95
+#define HOST_FONT_GLYPH_WIDTH 5
+#define HOST_FONT_GLYPH_HEIGHT 7
+
+extern const uint8_t host_font_glyphs[HOST_FONT_GLYPH_COUNT][HOST_FONT_GLYPH_HEIGHT];
+
+struct HostFont {
+  char name[48];
+  int16_t height; // line height
+  int16_t scale; // of the 5x7 glyphs
+};
+
+struct GBitmap {
+  uint8_t *data;
+  uint16_t row_size;
+  GBitmapFormat format;
+  GRect bounds;
+  GColor *palette;
+  bool free_palette;
+};
+
+// Drawing state, coordinates are translated by offset and clipped to clip,
+// both on screen
+struct GContext {
+  GBitmap *frame;
+  GPoint offset;
+  GRect clip;
+  GColor fill_color;
+  GColor stroke_color;
+  GColor text_color;
+  GCompOp compositing_mode;
+};
+
+struct Layer {
+  GRect frame;
+  GRect bounds;
+  bool hidden;
+  bool clips;
+  LayerUpdateProc update_proc;
+  struct Layer *parent;
+  struct Layer *first_child;
+  struct Layer *next_sibling;
+  Window *window; // only set on root layers
+  void *data;
+};
+
+typedef struct ClickConfig {
+  ClickHandler single;
+  uint16_t repeat_interval_ms;
+  ClickHandler long_down;
+  ClickHandler long_up;
+  uint16_t long_delay_ms;
+  ClickHandler raw_down;
+  ClickHandler raw_up;
+  void *raw_context;
+  void *context;
+} click_config_t;
+
+struct Window {
+  Layer *root;
+  GColor background;
+  WindowHandlers handlers;
+  ClickConfigProvider click_provider;
+  void *click_context;
+  click_config_t clicks[NUM_BUTTONS];
+  bool loaded;
+};
+
+struct TextLayer {
+  Layer *layer;
+  const char *text;
+  GFont font;
+  GColor text_color;
+  GColor background_color;
+  GTextAlignment alignment;
+  GTextOverflowMode overflow_mode;
+};
+
+struct BitmapLayer {
+  Layer *layer;
+  const GBitmap *bitmap;
+  GCompOp compositing_mode;
+};
+
+struct ActionBarLayer {
+  Layer *layer;
+  const GBitmap *icons[NUM_BUTTONS];
+  ClickConfigProvider click_provider;
+  Window *window;
+};
+
+struct StatusBarLayer {
+  Layer *layer;
+  GColor background;
+  GColor foreground;
+};
+
+struct MenuLayer {
+  Layer *layer;
+  MenuLayerCallbacks callbacks;
+  void *context;
+  MenuIndex selected;
+  GColor normal_background, normal_foreground;
+  GColor highlight_background, highlight_foreground;
+};
+
+// Windows from the bottom of the stack up
+uint8_t host_window_stack(Window *windows[HOST_WINDOW_STACK_SIZE]);
+
+// The screen sized context, reset to the whole screen
+GContext *host_graphics_context(void);
+// Points the context at a layer: origin and clip rectangle on screen
+void host_graphics_set_drawing_box(GContext *ctx, GPoint origin, GRect clip);
+GRect host_grect_intersect(GRect a, GRect b);
+void host_graphics_draw_icon(GContext *ctx, const GBitmap *bitmap, GRect rect, GColor color);
@@ -0,0 +1,411 @@
+#pragma once
+
+// Host stand-in for the subset of the Pebble SDK used by the app, so that
+// src/c compiles for the desktop (see tools/simulate.py). Time is virtual:
+// time(), time_ms(), app timers and the tick service all run on the clock
+// driven by the host, see host.h. Platform: basalt, 144x168 colour, or the
+// one selected with HOST_PLATFORM_CHALK / HOST_PLATFORM_EMERY (--platform).
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// Virtual clock in place of the C library one
+time_t host_time(time_t *t);
+#define time(t) host_time(t)
+
+#define PBL_COLOR 1
+#if defined(HOST_PLATFORM_CHALK)
+#define PBL_ROUND 1
+#define PBL_PLATFORM_CHALK 1
+#define PBL_DISPLAY_WIDTH 180
+#define PBL_DISPLAY_HEIGHT 180
+#define PBL_IF_RECT_ELSE(if_true, if_false) (if_false)
+#define PBL_IF_ROUND_ELSE(if_true, if_false) (if_true)
+#elif defined(HOST_PLATFORM_EMERY)
+#define PBL_RECT 1
+#define PBL_PLATFORM_EMERY 1
+#define PBL_DISPLAY_WIDTH 200
+#define PBL_DISPLAY_HEIGHT 228
+#define PBL_IF_RECT_ELSE(if_true, if_false) (if_true)
+#define PBL_IF_ROUND_ELSE(if_true, if_false) (if_false)
+#else
+#define PBL_RECT 1
+#define PBL_PLATFORM_BASALT 1
+#define PBL_DISPLAY_WIDTH 144
+#define PBL_DISPLAY_HEIGHT 168
+#define PBL_IF_RECT_ELSE(if_true, if_false) (if_true)
+#define PBL_IF_ROUND_ELSE(if_true, if_false) (if_false)
+#endif
+#define PBL_IF_COLOR_ELSE(if_true, if_false) (if_true)
+#define PBL_IF_BW_ELSE(if_true, if_false) (if_false)
+#define PBL_API_EXISTS(api) 1
+
+#define ARRAY_LENGTH(array) (sizeof(array) / sizeof((array)[0]))
+#define SECONDS_PER_MINUTE 60
+#define SECONDS_PER_HOUR 3600
+#define SECONDS_PER_DAY 86400
+#define MINUTES_PER_HOUR 60
+#define TRIG_MAX_RATIO 0xffff
+#define TRIG_MAX_ANGLE 0x10000
+#define DEG_TO_TRIGANGLE(angle) (((angle) * TRIG_MAX_ANGLE) / 360)
+#define PERSIST_DATA_MAX_LENGTH 256
+#define ACTION_BAR_WIDTH 30
+#define STATUS_BAR_LAYER_HEIGHT 16
+#define MENU_CELL_BASIC_HEADER_HEIGHT 16
+
+typedef enum {
+  APP_LOG_LEVEL_ERROR = 1, APP_LOG_LEVEL_WARNING = 50, APP_LOG_LEVEL_INFO = 100,
+  APP_LOG_LEVEL_DEBUG = 200, APP_LOG_LEVEL_DEBUG_VERBOSE = 255
+} AppLogLevel;
+
+void host_app_log(AppLogLevel level, const char *file, int line, const char *format, ...)
+  __attribute__((format(printf, 4, 5)));
+#define APP_LOG(level, format, ...) host_app_log(level, __FILE__, __LINE__, format, ##__VA_ARGS__)
+
+///////////////////////////////////////////////////////////////////////////////
+// Geometry and colours
+
+typedef struct GPoint { int16_t x, y; } GPoint;
+typedef struct GSize { int16_t w, h; } GSize;
+typedef struct GRect { GPoint origin; GSize size; } GRect;
+typedef struct GEdgeInsets { int16_t top, right, bottom, left; } GEdgeInsets;
+
+#define GPoint(x, y) ((GPoint){ (x), (y) })
+#define GSize(w, h) ((GSize){ (w), (h) })
+#define GRect(x, y, w, h) ((GRect){ { (x), (y) }, { (w), (h) } })
+#define GPointZero GPoint(0, 0)
+#define GRectZero GRect(0, 0, 0, 0)
+
+GRect grect_inset(GRect rect, GEdgeInsets insets);
+
+// 8-bit ARGB, 2 bits per channel
+typedef union GColor8 {
+  uint8_t argb;
+  struct { uint8_t b:2, g:2, r:2, a:2; };
+} GColor8;
+typedef GColor8 GColor;
+
+#define GColorFromARGB(a, r, g, b) ((GColor){ .argb = (uint8_t)((a) << 6 | (r) << 4 | (g) << 2 | (b)) })
+#define GColorClear ((GColor){ .argb = 0x00 })
+#define GColorBlack ((GColor){ .argb = 0xC0 })
+#define GColorWhite ((GColor){ .argb = 0xFF })
+#define GColorDarkGray ((GColor){ .argb = 0xD5 })
+#define GColorLightGray ((GColor){ .argb = 0xEA })
+#define GColorRed ((GColor){ .argb = 0xF0 })
+#define GColorYellow ((GColor){ .argb = 0xFC })
+#define GColorJaegerGreen ((GColor){ .argb = 0xD9 })
+#define GColorGreen ((GColor){ .argb = 0xCC })
+#define GColorBlue ((GColor){ .argb = 0xC3 })
+#define GColorOrange ((GColor){ .argb = 0xF8 })
+#define GColorPictonBlue ((GColor){ .argb = 0xD7 })
+
+static inline bool gcolor_equal(GColor a, GColor b) {
+  return a.argb == b.argb;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Graphics
+
+typedef struct GContext GContext;
+typedef struct HostFont *GFont;
+typedef uint32_t ResHandle;
+
+typedef enum { GTextAlignmentLeft, GTextAlignmentCenter, GTextAlignmentRight } GTextAlignment;
+typedef enum { GTextOverflowModeWordWrap, GTextOverflowModeTrailingEllipsis, GTextOverflowModeFill } GTextOverflowMode;
+typedef enum { GCornerNone = 0, GCornersAll = 15 } GCornerMask;
+typedef enum { GCompOpAssign, GCompOpAssignInverted, GCompOpOr, GCompOpAnd, GCompOpClear, GCompOpSet } GCompOp;
+typedef enum {
+  GBitmapFormat1Bit, GBitmapFormat8Bit, GBitmapFormat1BitPalette, GBitmapFormat2BitPalette,
+  GBitmapFormat4BitPalette, GBitmapFormat8BitCircular
+} GBitmapFormat;
+
+typedef struct GBitmap GBitmap;
+typedef struct GBitmapDataRowInfo { uint8_t *data; int16_t min_x, max_x; } GBitmapDataRowInfo;
+
+GBitmap *gbitmap_create_with_resource(uint32_t resource_id);
+GBitmap *gbitmap_create_blank(GSize size, GBitmapFormat format);
+GBitmap *gbitmap_create_blank_with_palette(GSize size, GBitmapFormat format, GColor *palette, bool free_on_destroy);
+void gbitmap_destroy(GBitmap *bitmap);
+uint8_t *gbitmap_get_data(const GBitmap *bitmap);
+uint16_t gbitmap_get_bytes_per_row(const GBitmap *bitmap);
+GBitmapFormat gbitmap_get_format(const GBitmap *bitmap);
+GRect gbitmap_get_bounds(const GBitmap *bitmap);
+void gbitmap_set_bounds(GBitmap *bitmap, GRect bounds);
+GColor *gbitmap_get_palette(const GBitmap *bitmap);
+GBitmapDataRowInfo gbitmap_get_data_row_info(const GBitmap *bitmap, uint16_t y);
+
+GBitmap *graphics_capture_frame_buffer(GContext *ctx);
+bool graphics_release_frame_buffer(GContext *ctx, GBitmap *buffer);
+void graphics_context_set_fill_color(GContext *ctx, GColor color);
+void graphics_context_set_stroke_color(GContext *ctx, GColor color);
+void graphics_context_set_text_color(GContext *ctx, GColor color);
+void graphics_context_set_compositing_mode(GContext *ctx, GCompOp mode);
+void graphics_fill_rect(GContext *ctx, GRect rect, uint16_t corner_radius, GCornerMask corner_mask);
+void graphics_draw_rect(GContext *ctx, GRect rect);
+void graphics_draw_line(GContext *ctx, GPoint p0, GPoint p1);
+void graphics_draw_bitmap_in_rect(GContext *ctx, const GBitmap *bitmap, GRect rect);
+void graphics_draw_text(GContext *ctx, const char *text, GFont font, GRect box, GTextOverflowMode overflow_mode,
+                        GTextAlignment alignment, void *layout);
+GSize graphics_text_layout_get_content_size(const char *text, GFont font, GRect box, GTextOverflowMode overflow_mode,
+                                            GTextAlignment alignment);
+
+#define FONT_KEY_GOTHIC_09 "RESOURCE_ID_GOTHIC_09"
+#define FONT_KEY_GOTHIC_14 "RESOURCE_ID_GOTHIC_14"
+#define FONT_KEY_GOTHIC_18 "RESOURCE_ID_GOTHIC_18"
+#define FONT_KEY_GOTHIC_18_BOLD "RESOURCE_ID_GOTHIC_18_BOLD"
+#define FONT_KEY_GOTHIC_24 "RESOURCE_ID_GOTHIC_24"
+#define FONT_KEY_GOTHIC_24_BOLD "RESOURCE_ID_GOTHIC_24_BOLD"
+#define FONT_KEY_GOTHIC_28_BOLD "RESOURCE_ID_GOTHIC_28_BOLD"
+#define FONT_KEY_BITHAM_34_MEDIUM_NUMBERS "RESOURCE_ID_BITHAM_34_MEDIUM_NUMBERS"
+#define FONT_KEY_BITHAM_42_BOLD "RESOURCE_ID_BITHAM_42_BOLD"
+#define FONT_KEY_BITHAM_42_LIGHT "RESOURCE_ID_BITHAM_42_LIGHT"
+
+GFont fonts_get_system_font(const char *font_key);
+GFont fonts_load_custom_font(ResHandle handle);
+void fonts_unload_custom_font(GFont font);
+
+int32_t sin_lookup(int32_t angle);
+int32_t cos_lookup(int32_t angle);
+int32_t atan2_lookup(int16_t y, int16_t x);
+
+///////////////////////////////////////////////////////////////////////////////
+// Windows, layers and clicks
+
+typedef struct Window Window;
+typedef struct Layer Layer;
+typedef struct TextLayer TextLayer;
+typedef struct BitmapLayer BitmapLayer;
+typedef struct MenuLayer MenuLayer;
+typedef struct ActionBarLayer ActionBarLayer;
+typedef struct StatusBarLayer StatusBarLayer;
+typedef struct ClickRecognizer *ClickRecognizerRef;
+
+typedef enum { BUTTON_ID_BACK, BUTTON_ID_UP, BUTTON_ID_SELECT, BUTTON_ID_DOWN, NUM_BUTTONS } ButtonId;
+
+typedef void (*ClickHandler)(ClickRecognizerRef recognizer, void *context);
+typedef void (*ClickConfigProvider)(void *context);
+typedef void (*WindowHandler)(Window *window);
+typedef struct WindowHandlers { WindowHandler load, appear, disappear, unload; } WindowHandlers;
+typedef void (*LayerUpdateProc)(Layer *layer, GContext *ctx);
+
+Window *window_create(void);
+void window_destroy(Window *window);
+void window_set_window_handlers(Window *window, WindowHandlers handlers);
+void window_set_background_color(Window *window, GColor color);
+Layer *window_get_root_layer(const Window *window);
+void window_set_click_config_provider(Window *window, ClickConfigProvider provider);
+void window_set_click_config_provider_with_context(Window *window, ClickConfigProvider provider, void *context);
+void window_set_click_context(ButtonId button, void *context);
+void window_single_click_subscribe(ButtonId button, ClickHandler handler);
+void window_single_repeating_click_subscribe(ButtonId button, uint16_t repeat_interval_ms, ClickHandler handler);
+void window_long_click_subscribe(ButtonId button, uint16_t delay_ms, ClickHandler down_handler, ClickHandler up_handler);
+void window_raw_click_subscribe(ButtonId button, ClickHandler down_handler, ClickHandler up_handler, void *context);
+uint8_t click_number_of_clicks_counted(ClickRecognizerRef recognizer);
+ButtonId click_recognizer_get_button_id(ClickRecognizerRef recognizer);
+
+void window_stack_push(Window *window, bool animated);
+Window *window_stack_pop(bool animated);
+void window_stack_pop_all(bool animated);
+bool window_stack_remove(Window *window, bool animated);
+Window *window_stack_get_top_window(void);
+bool window_stack_contains_window(Window *window);
+
+Layer *layer_create(GRect frame);
+Layer *layer_create_with_data(GRect frame, size_t data_size);
+void layer_destroy(Layer *layer);
+void *layer_get_data(const Layer *layer);
+void layer_set_update_proc(Layer *layer, LayerUpdateProc update_proc);
+void layer_add_child(Layer *parent, Layer *child);
+void layer_mark_dirty(Layer *layer);
+GRect layer_get_bounds(const Layer *layer);
+GRect layer_get_frame(const Layer *layer);
+void layer_set_frame(Layer *layer, GRect frame);
+void layer_set_hidden(Layer *layer, bool hidden);
+void layer_set_clips(Layer *layer, bool clips);
+Window *layer_get_window(const Layer *layer);
+GPoint layer_convert_point_to_screen(const Layer *layer, GPoint point);
+
+TextLayer *text_layer_create(GRect frame);
+void text_layer_destroy(TextLayer *text_layer);
+Layer *text_layer_get_layer(TextLayer *text_layer);
+void text_layer_set_text(TextLayer *text_layer, const char *text);
+void text_layer_set_font(TextLayer *text_layer, GFont font);
+void text_layer_set_text_color(TextLayer *text_layer, GColor color);
+void text_layer_set_background_color(TextLayer *text_layer, GColor color);
+void text_layer_set_text_alignment(TextLayer *text_layer, GTextAlignment alignment);
+
+BitmapLayer *bitmap_layer_create(GRect frame);
+void bitmap_layer_destroy(BitmapLayer *bitmap_layer);
+Layer *bitmap_layer_get_layer(const BitmapLayer *bitmap_layer);
+void bitmap_layer_set_bitmap(BitmapLayer *bitmap_layer, const GBitmap *bitmap);
+void bitmap_layer_set_compositing_mode(BitmapLayer *bitmap_layer, GCompOp mode);
+
+ActionBarLayer *action_bar_layer_create(void);
+void action_bar_layer_destroy(ActionBarLayer *action_bar);
+void action_bar_layer_set_icon(ActionBarLayer *action_bar, ButtonId button, const GBitmap *icon);
+void action_bar_layer_add_to_window(ActionBarLayer *action_bar, Window *window);
+void action_bar_layer_set_click_config_provider(ActionBarLayer *action_bar, ClickConfigProvider provider);
+
+StatusBarLayer *status_bar_layer_create(void);
+void status_bar_layer_destroy(StatusBarLayer *status_bar);
+Layer *status_bar_layer_get_layer(StatusBarLayer *status_bar);
+void status_bar_layer_set_colors(StatusBarLayer *status_bar, GColor background, GColor foreground);
+
+typedef struct MenuIndex { uint16_t section, row; } MenuIndex;
+typedef enum { MenuRowAlignNone, MenuRowAlignCenter, MenuRowAlignTop, MenuRowAlignBottom } MenuRowAlign;
+typedef uint16_t (*MenuLayerGetNumberOfSectionsCallback)(MenuLayer *menu_layer, void *context);
+typedef uint16_t (*MenuLayerGetNumberOfRowsInSectionsCallback)(MenuLayer *menu_layer, uint16_t section_index, void *context);
+typedef int16_t (*MenuLayerGetCellHeightCallback)(MenuLayer *menu_layer, MenuIndex *cell_index, void *context);
+typedef int16_t (*MenuLayerGetHeaderHeightCallback)(MenuLayer *menu_layer, uint16_t section_index, void *context);
+typedef void (*MenuLayerDrawRowCallback)(GContext *ctx, const Layer *cell_layer, MenuIndex *cell_index, void *context);
+typedef void (*MenuLayerDrawHeaderCallback)(GContext *ctx, const Layer *cell_layer, uint16_t section_index, void *context);
+typedef void (*MenuLayerSelectCallback)(MenuLayer *menu_layer, MenuIndex *cell_index, void *context);
+typedef struct MenuLayerCallbacks {
+  MenuLayerGetNumberOfSectionsCallback get_num_sections;
+  MenuLayerGetNumberOfRowsInSectionsCallback get_num_rows;
+  MenuLayerGetCellHeightCallback get_cell_height;
+  MenuLayerGetHeaderHeightCallback get_header_height;
+  MenuLayerDrawRowCallback draw_row;
+  MenuLayerDrawHeaderCallback draw_header;
+  MenuLayerSelectCallback select_click;
+  MenuLayerSelectCallback select_long_click;
+} MenuLayerCallbacks;
+
+MenuLayer *menu_layer_create(GRect frame);
+void menu_layer_destroy(MenuLayer *menu_layer);
+Layer *menu_layer_get_layer(const MenuLayer *menu_layer);
+void menu_layer_set_callbacks(MenuLayer *menu_layer, void *context, MenuLayerCallbacks callbacks);
+void menu_layer_set_click_config_onto_window(MenuLayer *menu_layer, Window *window);
+void menu_layer_set_normal_colors(MenuLayer *menu_layer, GColor background, GColor foreground);
+void menu_layer_set_highlight_colors(MenuLayer *menu_layer, GColor background, GColor foreground);
+void menu_layer_reload_data(MenuLayer *menu_layer);
+void menu_layer_set_selected_index(MenuLayer *menu_layer, MenuIndex index, MenuRowAlign align, bool animated);
+void menu_layer_set_selected_next(MenuLayer *menu_layer, bool up, MenuRowAlign align, bool animated);
+void menu_cell_basic_draw(GContext *ctx, const Layer *cell_layer, const char *title, const char *subtitle, GBitmap *icon);
+void menu_cell_basic_header_draw(GContext *ctx, const Layer *cell_layer, const char *title);
+
+///////////////////////////////////////////////////////////////////////////////
+// Event services and timers
+
+typedef enum { SECOND_UNIT = 1, MINUTE_UNIT = 2, HOUR_UNIT = 4, DAY_UNIT = 8, MONTH_UNIT = 16, YEAR_UNIT = 32 } TimeUnits;
+typedef void (*TickHandler)(struct tm *tick_time, TimeUnits units_changed);
+typedef struct BatteryChargeState { uint8_t charge_percent; bool is_charging; bool is_plugged; } BatteryChargeState;
+typedef void (*BatteryStateHandler)(BatteryChargeState charge);
+
+uint16_t time_ms(time_t *t, uint16_t *out_ms);
+void tick_timer_service_subscribe(TimeUnits tick_units, TickHandler handler);
+void tick_timer_service_unsubscribe(void);
+void battery_state_service_subscribe(BatteryStateHandler handler);
+BatteryChargeState battery_state_service_peek(void);
+
+typedef struct AppTimer AppTimer;
+typedef void (*AppTimerCallback)(void *data);
+AppTimer *app_timer_register(uint32_t timeout_ms, AppTimerCallback callback, void *callback_data);
+bool app_timer_reschedule(AppTimer *timer, uint32_t new_timeout_ms);
+void app_timer_cancel(AppTimer *timer);
+
+typedef struct VibePattern { const uint32_t *durations; uint32_t num_segments; } VibePattern;
+void vibes_enqueue_custom_pattern(VibePattern pattern);
+void light_enable_interaction(void);
+
+void app_event_loop(void);
+size_t heap_bytes_free(void);
+size_t heap_bytes_used(void);
+
+///////////////////////////////////////////////////////////////////////////////
+// Storage, resources, data logging and app messages
+
+bool persist_exists(uint32_t key);
+int persist_read_data(uint32_t key, void *buffer, size_t buffer_size);
+int persist_write_data(uint32_t key, const void *data, size_t size);
+bool persist_read_bool(uint32_t key);
+int persist_write_bool(uint32_t key, bool value);
+int persist_delete(uint32_t key);
+
+ResHandle resource_get_handle(uint32_t resource_id);
+size_t resource_size(ResHandle handle);
+size_t resource_load_byte_range(ResHandle handle, uint32_t start_offset, uint8_t *buffer, size_t num_bytes);
+
+typedef struct DataLoggingSession *DataLoggingSessionRef;
+typedef enum { DATA_LOGGING_BYTE_ARRAY = 0, DATA_LOGGING_UINT = 2, DATA_LOGGING_INT = 3 } DataLoggingItemType;
+typedef enum {
+  DATA_LOGGING_SUCCESS = 0, DATA_LOGGING_BUSY, DATA_LOGGING_FULL, DATA_LOGGING_NOT_FOUND,
+  DATA_LOGGING_CLOSED, DATA_LOGGING_INVALID_PARAMS, DATA_LOGGING_INTERNAL_ERR
+} DataLoggingResult;
+DataLoggingSessionRef data_logging_create(uint32_t tag, DataLoggingItemType item_type, uint16_t item_length, bool resume);
+DataLoggingResult data_logging_log(DataLoggingSessionRef session, const void *data, uint32_t num_items);
+void data_logging_finish(DataLoggingSessionRef session);
+
+typedef uint32_t PublishedId;
+typedef struct AppGlanceReloadSession AppGlanceReloadSession;
+typedef enum {
+  APP_GLANCE_RESULT_SUCCESS = 0, APP_GLANCE_RESULT_INVALID_TEMPLATE_STRING = 1, APP_GLANCE_RESULT_TEMPLATE_STRING_TOO_LONG = 2,
+  APP_GLANCE_RESULT_INVALID_ICON = 4, APP_GLANCE_RESULT_SLICE_CAPACITY_EXCEEDED = 8, APP_GLANCE_RESULT_EXPIRES_IN_THE_PAST = 16,
+  APP_GLANCE_RESULT_INVALID_SESSION = 32
+} AppGlanceResult;
+typedef struct {
+  struct {
+    PublishedId icon;
+    const char *subtitle_template_string;
+  } layout;
+  time_t expiration_time;
+} AppGlanceSlice;
+#define APP_GLANCE_SLICE_DEFAULT_ICON ((PublishedId)0)
+#define APP_GLANCE_SLICE_NO_EXPIRATION ((time_t)0)
+typedef void (*AppGlanceReloadCallback)(AppGlanceReloadSession *session, size_t limit, void *context);
+void app_glance_reload(AppGlanceReloadCallback callback, void *context);
+AppGlanceResult app_glance_add_slice(AppGlanceReloadSession *session, AppGlanceSlice slice);
+
+typedef enum {
+  APP_MSG_OK = 0, APP_MSG_SEND_TIMEOUT = 2, APP_MSG_SEND_REJECTED = 4, APP_MSG_NOT_CONNECTED = 8,
+  APP_MSG_APP_NOT_RUNNING = 16, APP_MSG_INVALID_ARGS = 32, APP_MSG_BUSY = 64, APP_MSG_BUFFER_OVERFLOW = 128,
+  APP_MSG_OUT_OF_MEMORY = 1024, APP_MSG_CLOSED = 2048, APP_MSG_INTERNAL_ERROR = 4096
+} AppMessageResult;
+typedef enum { DICT_OK = 0, DICT_NOT_ENOUGH_STORAGE = 2, DICT_INVALID_ARGS = 4 } DictionaryResult;
+typedef enum { TUPLE_BYTE_ARRAY = 0, TUPLE_CSTRING = 1, TUPLE_UINT = 2, TUPLE_INT = 3 } TupleType;
+
+typedef struct __attribute__((__packed__)) Tuple {
+  uint32_t key;
+  TupleType type:8;
+  uint16_t length;
+  union {
+    uint8_t data[0];
+    char cstring[0];
+    uint8_t uint8;
+    uint16_t uint16;
+    uint32_t uint32;
+    int8_t int8;
+    int16_t int16;
+    int32_t int32;
+  } value[];
+} Tuple;
+
+typedef struct DictionaryIterator DictionaryIterator;
+typedef void (*AppMessageInboxReceived)(DictionaryIterator *iterator, void *context);
+typedef void (*AppMessageInboxDropped)(AppMessageResult reason, void *context);
+typedef void (*AppMessageOutboxSent)(DictionaryIterator *iterator, void *context);
+typedef void (*AppMessageOutboxFailed)(DictionaryIterator *iterator, AppMessageResult reason, void *context);
+
+AppMessageResult app_message_open(uint32_t size_inbound, uint32_t size_outbound);
+uint32_t app_message_inbox_size_maximum(void);
+uint32_t app_message_outbox_size_maximum(void);
+AppMessageResult app_message_outbox_begin(DictionaryIterator **iterator);
+AppMessageResult app_message_outbox_send(void);
+AppMessageInboxReceived app_message_register_inbox_received(AppMessageInboxReceived received_callback);
+AppMessageInboxDropped app_message_register_inbox_dropped(AppMessageInboxDropped dropped_callback);
+AppMessageOutboxSent app_message_register_outbox_sent(AppMessageOutboxSent sent_callback);
+AppMessageOutboxFailed app_message_register_outbox_failed(AppMessageOutboxFailed failed_callback);
+uint32_t dict_calc_buffer_size(const uint8_t tuple_count, ...);
+Tuple *dict_find(const DictionaryIterator *iter, const uint32_t key);
+DictionaryResult dict_write_data(DictionaryIterator *iter, const uint32_t key, const uint8_t *data, const uint16_t size);
+DictionaryResult dict_write_uint8(DictionaryIterator *iter, const uint32_t key, const uint8_t value);
+DictionaryResult dict_write_uint16(DictionaryIterator *iter, const uint32_t key, const uint16_t value);
+
+// Generated by tools/simulate.py from package.json
+#include "message_keys.auto.h"
+#include "resource_ids.auto.h"
@@ -0,0 +1,456 @@
+// Time-warp simulator: runs the app against the host SDK stand-in, drives it
+// from a scenario script and prints a timeline of what it did. Built and run
+// by tools/simulate.py.
+//
+//   sim [--start YYYY-MM-DDTHH:MM[:SS]] [--verbose] [--frames DIR] [--runs N] scenario.txt
+//
+// Scenario lines, '#' starts a comment:
+//   press <back|up|select|down> [count]
+//   hold <button> [duration]      1s when left out
+//   wait <duration>               e.g. 500ms, 90s, 1h30m
+//   at <hh:mm[:ss]>               waits until that time of day (UTC)
+//   battery <percent> [charging]
+//   mark <text>                   copied to the timeline
+//   plan <duration>...            sends a flight plan with one leg per
+//                                 duration, as the phone would
+//   frame <name>                  renders the screen to DIR/<name>.ppm, the
+//                                 render time goes to stderr
+
+#include <stdarg.h>
+#include <time.h>
+#include "host.h"
+#include "../../src/c/services/telemetry.h"
+#include "../../src/c/services/flight_plan.h"
+#include "../../src/c/utils.h"
+
+int pebble_app_main(void);
+
+#define TELEMETRY_TAG 0x464C0001
+#define MAX_ENTRIES 4096
+#define MAX_LINE 256
+
+typedef struct Entry {
+  uint64_t at;
+  uint32_t order;
+  char text[MAX_LINE];
+} entry_t;
+
+static const char *EVENTS[] = {
+  "phase_next", "phase_cancel", "alarm_fire", "alarm_ack", "et_flyback", "waypoint", "touch_and_go"
+};
+static const char *PHASES[] = { "preflight", "taxi_dep", "inflight", "taxi_arr", "postflight" };
+static const char *ALARMS[] = { "cruise_check", "endurance", "flight_plan", "battery" };
+
+static entry_t s_entries[MAX_ENTRIES];
+static uint32_t s_entry_count;
+static uint64_t s_start;
+static FILE *s_script;
+static const char *s_script_name;
+static bool s_verbose;
+static const char *s_frames_dir;
+static int s_render_runs = 20;
+static int s_status;
+
+///////////////////////////////////////////////////////////////////////////////
+// Timeline
+
+static void entry_add(uint64_t at, const char *format, ...) {
+  if (s_entry_count == MAX_ENTRIES) {
+    return;
+  }
+  entry_t *entry = &s_entries[s_entry_count];
+  entry->at = at;
+  entry->order = s_entry_count++;
+  va_list args;
+  va_start(args, format);
+  vsnprintf(entry->text, sizeof(entry->text), format, args);
+  va_end(args);
+}
+
+static int entry_compare(const void *a, const void *b) {
+  const entry_t *x = a, *y = b;
+  if (x->at != y->at) {
+    return x->at < y->at ? -1 : 1;
+  }
+  return x->order < y->order ? -1 : 1;
+}
+
+static void timeline_print(void) {
+  qsort(s_entries, s_entry_count, sizeof(entry_t), entry_compare);
+  for (uint32_t i = 0; i < s_entry_count; i++) {
+    uint64_t elapsed = s_entries[i].at > s_start ? s_entries[i].at - s_start : 0;
+    printf("%2u:%02u:%02u.%03u  %s\n", (unsigned)(elapsed / 3600000), (unsigned)(elapsed / 60000 % 60),
+           (unsigned)(elapsed / 1000 % 60), (unsigned)(elapsed % 1000), s_entries[i].text);
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Hooks
+
+static void log_hook(AppLogLevel level, const char *message) {
+  if (s_verbose || level <= APP_LOG_LEVEL_INFO) {
+    entry_add(host_clock_now(), "log      %s", message);
+  }
+}
+
+static void vibe_hook(const VibePattern *pattern) {
+  char text[MAX_LINE] = "";
+  size_t length = 0;
+  for (uint32_t i = 0; i < pattern->num_segments && length < sizeof(text); i++) {
+    length += snprintf(text + length, sizeof(text) - length, i ? ",%u" : "%u", (unsigned)pattern->durations[i]);
+  }
+  entry_add(host_clock_now(), "vibe     %s", text);
+}
+
+static void light_hook(void) {
+  entry_add(host_clock_now(), "light");
+}
+
+// The template strings are shown as the app wrote them, with the expiry
+static void glance_hook(const AppGlanceSlice *slices, size_t count) {
+  if (count == 0) {
+    entry_add(host_clock_now(), "glance   none");
+  }
+  for (size_t i = 0; i < count; i++) {
+    if (slices[i].expiration_time == APP_GLANCE_SLICE_NO_EXPIRATION) {
+      entry_add(host_clock_now(), "glance   %s", slices[i].layout.subtitle_template_string);
+    } else {
+      uint64_t until = (uint64_t)slices[i].expiration_time * 1000 - s_start;
+      entry_add(host_clock_now(), "glance   %s (until %u:%02u:%02u)", slices[i].layout.subtitle_template_string,
+                (unsigned)(until / 3600000), (unsigned)(until / 60000 % 60), (unsigned)(until / 1000 % 60));
+    }
+  }
+}
+
+static const char *name_of(const char *const *names, size_t count, uint8_t index) {
+  return index < count ? names[index] : "?";
+}
+
+// Telemetry is staged by the app, so records arrive late: they are placed on
+// the timeline by their own timestamp
+static void data_logging_hook(uint32_t tag, const void *items, uint32_t count, uint16_t item_length) {
+  if (tag != TELEMETRY_TAG) {
+    return;
+  }
+  const uint8_t *bytes = items;
+  for (uint32_t i = 0; i + sizeof(telemetry_record_t) <= count * item_length; i += sizeof(telemetry_record_t)) {
+    telemetry_record_t record;
+    memcpy(&record, bytes + i, sizeof(record));
+    uint64_t at = (uint64_t)record.timestamp * 1000 + record.ms;
+    const char *event = name_of(EVENTS, ARRAY_LENGTH(EVENTS), record.event);
+    switch (record.event) {
+      case EVENT_PHASE_NEXT:
+      case EVENT_PHASE_CANCEL:
+        entry_add(at, "event    %s %s", event, name_of(PHASES, ARRAY_LENGTH(PHASES), record.arg));
+        break;
+      case EVENT_ALARM_FIRE:
+      case EVENT_ALARM_ACK:
+        entry_add(at, "event    %s %s", event, name_of(ALARMS, ARRAY_LENGTH(ALARMS), record.arg));
+        break;
+      case EVENT_WAYPOINT:
+      case EVENT_TOUCH_AND_GO:
+        entry_add(at, "event    %s %u", event, record.arg);
+        break;
+      default:
+        entry_add(at, "event    %s", event);
+        break;
+    }
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Frames
+
+static uint64_t now_ns(void) {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (uint64_t)now.tv_sec * 1000000000 + now.tv_nsec;
+}
+
+static bool frame_write(const char *name, const GBitmap *frame) {
+  char path[512];
+  snprintf(path, sizeof(path), "%s/%s.ppm", s_frames_dir, name);
+  FILE *file = fopen(path, "wb");
+  if (!file) {
+    perror(path);
+    return false;
+  }
+  GRect bounds = gbitmap_get_bounds(frame);
+  fprintf(file, "P6\n%d %d\n255\n", bounds.size.w, bounds.size.h);
+  for (int y = 0; y < bounds.size.h; y++) {
+    const uint8_t *row = gbitmap_get_data_row_info(frame, y).data;
+    for (int x = 0; x < bounds.size.w; x++) {
+      GColor color = { .argb = row[x] };
+      uint8_t rgb[] = { color.r * 85, color.g * 85, color.b * 85 };
+      fwrite(rgb, 1, sizeof(rgb), file);
+    }
+  }
+  fclose(file);
+  return true;
+}
+
+// The first render builds the caches, e.g. the digit atlases, so it is
+// reported apart from the best of the next ones
+static bool frame_render(const char *name) {
+  uint64_t start = now_ns();
+  const GBitmap *frame = host_render_frame();
+  uint64_t first = now_ns() - start;
+  uint64_t best = UINT64_MAX, total = 0;
+  for (int i = 1; i < s_render_runs; i++) {
+    start = now_ns();
+    frame = host_render_frame();
+    uint64_t elapsed = now_ns() - start;
+    total += elapsed;
+    if (elapsed < best) {
+      best = elapsed;
+    }
+  }
+  if (s_render_runs > 1) {
+    fprintf(stderr, "frame %-24s first %6llu us  best %6llu us  mean %6llu us\n", name,
+            (unsigned long long)(first / 1000), (unsigned long long)(best / 1000),
+            (unsigned long long)(total / (s_render_runs - 1) / 1000));
+  } else {
+    fprintf(stderr, "frame %-24s %6llu us\n", name, (unsigned long long)(first / 1000));
+  }
+  entry_add(host_clock_now(), "frame    %s", name);
+  return !s_frames_dir || frame_write(name, frame);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Scenario
+
+static void fail(int line, const char *message, const char *word) {
+  fprintf(stderr, "%s:%d: %s '%s'\n", s_script_name, line, message, word ? word : "");
+  s_status = 1;
+}
+
+// Sums number and unit pairs, a bare number is in seconds
+static bool parse_duration(const char *text, uint32_t *ms) {
+  uint64_t total = 0;
+  while (*text) {
+    char *end;
+    unsigned long value = strtoul(text, &end, 10);
+    if (end == text) {
+      return false;
+    }
+    uint32_t unit = 1000;
+    if (strncmp(end, "ms", 2) == 0) {
+      unit = 1;
+      end += 2;
+    } else if (*end == 's') {
+      end++;
+    } else if (*end == 'm') {
+      unit = 60000;
+      end++;
+    } else if (*end == 'h') {
+      unit = 3600000;
+      end++;
+    } else if (*end != '\0') {
+      return false;
+    }
+    total += (uint64_t)value * unit;
+    text = end;
+  }
+  *ms = total;
+  return true;
+}
+
+static bool parse_button(const char *text, ButtonId *button) {
+  static const char *names[NUM_BUTTONS] = { "back", "up", "select", "down" };
+  for (int i = 0; text && i < NUM_BUTTONS; i++) {
+    if (strcmp(text, names[i]) == 0) {
+      *button = i;
+      return true;
+    }
+  }
+  return false;
+}
+
+static void put_uint16(uint8_t *data, uint16_t value) {
+  data[0] = value & 0xff;
+  data[1] = value >> 8;
+}
+
+// Legs W1, W2... at 20 units per hour from 60 units on board, in the layout
+// of flight_plan_import
+static bool plan_send(char *durations) {
+  uint8_t data[16 + FLIGHT_PLAN_MAX_LEGS * 8 + 2] = { 1, 0, 'D', 'E', 'P', ' ', 'A', 'L', 'T', ' ' };
+  put_uint16(data + 10, 600);
+  put_uint16(data + 12, 200);
+  put_uint16(data + 14, 1800);
+  uint8_t count = 0;
+  for (char *text = strtok(durations, " \t"); text; text = strtok(NULL, " \t")) {
+    uint32_t ms;
+    if (count == FLIGHT_PLAN_MAX_LEGS || !parse_duration(text, &ms)) {
+      return false;
+    }
+    uint8_t *leg = data + 16 + count * 8;
+    snprintf((char *)leg, 5, "W%-3d", count + 1);
+    put_uint16(leg + 4, ms / 1000);
+    put_uint16(leg + 6, 200);
+    count++;
+  }
+  data[1] = count;
+  uint16_t length = 16 + count * 8;
+  put_uint16(data + length, fletcher16(data, length));
+  return flight_plan_import(data, length + 2) == PLAN_OK;
+}
+
+static void run_line(int number, char *line) {
+  char *hash = strchr(line, '#');
+  if (hash) {
+    *hash = '\0';
+  }
+  char *command = strtok(line, " \t\r\n");
+  if (!command) {
+    return;
+  }
+  char *arg = strtok(NULL, " \t\r\n");
+  char *extra = strtok(NULL, "\r\n");
+  if (extra) {
+    extra += strspn(extra, " \t");
+    for (char *end = extra + strlen(extra); end > extra && (end[-1] == ' ' || end[-1] == '\t'); ) {
+      *--end = '\0';
+    }
+    if (*extra == '\0') {
+      extra = NULL;
+    }
+  }
+  ButtonId button;
+  uint32_t ms;
+
+  if (strcmp(command, "press") == 0) {
+    if (!parse_button(arg, &button)) {
+      return fail(number, "unknown button", arg);
+    }
+    int count = extra ? atoi(extra) : 1;
+    for (int i = 0; i < count; i++) {
+      host_click(button, 0);
+    }
+  } else if (strcmp(command, "hold") == 0) {
+    if (!parse_button(arg, &button)) {
+      return fail(number, "unknown button", arg);
+    }
+    if (!extra) {
+      ms = 1000;
+    } else if (!parse_duration(extra, &ms)) {
+      return fail(number, "bad duration", extra);
+    }
+    host_click(button, ms);
+  } else if (strcmp(command, "wait") == 0) {
+    if (!arg || !parse_duration(arg, &ms)) {
+      return fail(number, "bad duration", arg);
+    }
+    host_advance(ms);
+  } else if (strcmp(command, "at") == 0) {
+    unsigned hours = 0, minutes = 0, seconds = 0;
+    if (!arg || sscanf(arg, "%u:%u:%u", &hours, &minutes, &seconds) < 2) {
+      return fail(number, "bad time", arg);
+    }
+    uint64_t day_ms = host_clock_now() % (SECONDS_PER_DAY * 1000ULL);
+    uint64_t target = (hours * 3600ULL + minutes * 60 + seconds) * 1000;
+    host_advance(target >= day_ms ? target - day_ms : target + SECONDS_PER_DAY * 1000ULL - day_ms);
+  } else if (strcmp(command, "battery") == 0) {
+    if (!arg) {
+      return fail(number, "missing percent", arg);
+    }
+    bool charging = extra && strcmp(extra, "charging") == 0;
+    host_set_battery((BatteryChargeState) {
+      .charge_percent = atoi(arg),
+      .is_charging = charging,
+      .is_plugged = charging,
+    });
+    entry_add(host_clock_now(), "battery  %s%%%s", arg, charging ? " charging" : "");
+  } else if (strcmp(command, "mark") == 0) {
+    entry_add(host_clock_now(), "mark     %s%s%s", arg ? arg : "", extra ? " " : "", extra ? extra : "");
+  } else if (strcmp(command, "plan") == 0) {
+    char legs[MAX_LINE];
+    snprintf(legs, sizeof(legs), "%s%s%s", arg ? arg : "", extra ? " " : "", extra ? extra : "");
+    entry_add(host_clock_now(), "plan     %s", legs);
+    if (!arg || !plan_send(legs)) {
+      return fail(number, "bad flight plan", arg);
+    }
+  } else if (strcmp(command, "frame") == 0) {
+    if (!arg || strchr(arg, '/')) {
+      return fail(number, "bad frame name", arg);
+    }
+    if (!frame_render(arg)) {
+      s_status = 1;
+    }
+  } else {
+    fail(number, "unknown command", command);
+  }
+}
+
+static void scenario_event_loop(void) {
+  char line[MAX_LINE];
+  for (int number = 1; s_status == 0 && fgets(line, sizeof(line), s_script); number++) {
+    if (host_top_window() == NULL) {
+      entry_add(host_clock_now(), "exit");
+      break;
+    }
+    run_line(number, line);
+  }
+}
+
+static bool parse_start(const char *text, time_t *start) {
+  struct tm tm = { 0 };
+  if (sscanf(text, "%d-%d-%dT%d:%d:%d", &tm.tm_year, &tm.tm_mon, &tm.tm_mday,
+             &tm.tm_hour, &tm.tm_min, &tm.tm_sec) < 5) {
+    return false;
+  }
+  tm.tm_year -= 1900;
+  tm.tm_mon -= 1;
+  *start = timegm(&tm);
+  return true;
+}
+
+int main(int argc, char **argv) {
+  // Fixed default so that timelines compare from run to run
+  time_t start = 1717228800; // 2024-06-01 08:00 UTC
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--start") == 0 && i + 1 < argc) {
+      if (!parse_start(argv[++i], &start)) {
+        fprintf(stderr, "bad start time '%s'\n", argv[i]);
+        return 2;
+      }
+    } else if (strcmp(argv[i], "--verbose") == 0) {
+      s_verbose = true;
+    } else if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc) {
+      s_frames_dir = argv[++i];
+    } else if (strcmp(argv[i], "--runs") == 0 && i + 1 < argc) {
+      s_render_runs = atoi(argv[++i]);
+      if (s_render_runs < 1) {
+        s_render_runs = 1;
+      }
+    } else {
+      s_script_name = argv[i];
+    }
+  }
+  if (!s_script_name) {
+    fprintf(stderr, "usage: %s [--start YYYY-MM-DDTHH:MM[:SS]] [--verbose] [--frames DIR] [--runs N] scenario.txt\n",
+            argv[0]);
+    return 2;
+  }
+  s_script = fopen(s_script_name, "r");
+  if (!s_script) {
+    perror(s_script_name);
+    return 2;
+  }
+
+  host_clock_set(start);
+  s_start = host_clock_now();
+  host_set_hooks((HostHooks) {
+    .event_loop = scenario_event_loop,
+    .log = log_hook,
+    .vibe = vibe_hook,
+    .light = light_hook,
+    .data_logging = data_logging_hook,
+    .glance = glance_hook,
+  });
+  pebble_app_main();
+  fclose(s_script);
+
+  timeline_print();
+  return s_status;
+}
@@ -0,0 +1,64 @@
+#!/usr/bin/env python3
+"""Report the RAM taken by the app binary on each platform.
+
+Run after `pebble build`, with the SDK toolchain on the PATH:
+
+    tools/memory_report.py [build]
+
+The code and static data of pebble-app.elf are loaded into the app RAM of
+the platform, what is left is the app heap: the windows, layers, bitmaps
+and custom fonts. The heap in use at start-up is logged by STARTUP_TRACE
+builds. Exits with an error when a platform has less than HEAP_MARGIN left.
+"""
+
+import os
+import subprocess
+import sys
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+APP_RAM = {
+    'basalt': 64 * 1024,
+    'chalk': 64 * 1024,
+    'diorite': 64 * 1024,
+    'emery': 128 * 1024,
+}
+
+# Room for the windows, layers and bitmaps, all built before off-block
+HEAP_MARGIN = 8 * 1024
+
+SIZE_TOOL = 'arm-none-eabi-size'
+
+
+def footprint(elf):
+    output = subprocess.check_output([SIZE_TOOL, elf]).decode()
+    text, data, bss = (int(value) for value in output.splitlines()[1].split()[:3])
+    return text, data, bss
+
+
+def main():
+    build = sys.argv[1] if len(sys.argv) > 1 else os.path.join(ROOT, 'build')
+    found = False
+    short = []
+
+    for platform in sorted(APP_RAM):
+        elf = os.path.join(build, platform, 'pebble-app.elf')
+        if not os.path.exists(elf):
+            continue
+        text, data, bss = footprint(elf)
+        used = text + data + bss
+        heap = APP_RAM[platform] - used
+        print('{:10} text {:>6}  data {:>5}  bss {:>5}  {:>6} of {:>6} bytes, heap {:>6}'.format(
+            platform, text, data, bss, used, APP_RAM[platform], heap))
+        if heap < HEAP_MARGIN:
+            short.append(platform)
+        found = True
+
+    if not found:
+        sys.exit('no pebble-app.elf under {}, run pebble build first'.format(build))
+    if short:
+        sys.exit('less than {} bytes of heap on {}'.format(HEAP_MARGIN, ', '.join(short)))
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,221 @@
+#!/usr/bin/env python3
+"""Pack the data tables described in resources/data/tables.yaml.
+
+Every table becomes a raw resource with this layout, little-endian:
+
+    char magic[4]     "FLDT"
+    uint8 version     TABLE_VERSION
+    uint8 key size
+    uint16 count
+    uint16 record size, 0 when records have variable length
+    uint16 index offset
+    uint32 CRC-32 of everything after the header
+    count * { key[key size], uint16 offset, uint16 length }, sorted by key
+    records
+
+The generated C header gives the offsets, sizes, record structs and
+checksums, so the watch binary-searches the index in flash without
+parsing anything at start-up.
+
+Usage: tools/pack_resources.py [project directory]
+"""
+
+import csv
+import json
+import os
+import struct
+import sys
+import zlib
+
+import yaml
+
+MAGIC = b'FLDT'
+TABLE_VERSION = 1
+HEADER = struct.Struct('<4sBBHHHI')
+
+FIELD_TYPES = {
+    'int8': ('b', 'int8_t'), 'uint8': ('B', 'uint8_t'),
+    'int16': ('h', 'int16_t'), 'uint16': ('H', 'uint16_t'),
+    'int32': ('i', 'int32_t'), 'uint32': ('I', 'uint32_t'),
+}
+
+
+class Table(object):
+    def __init__(self, name, key_size, record_size):
+        self.name = name
+        self.key_size = key_size
+        self.record_size = record_size
+        self.entries = []  # (key bytes, record bytes)
+        self.defines = []  # extra lines for the generated header
+
+    def add(self, key, record):
+        if len(key) != self.key_size:
+            raise ValueError('%s: key %r is not %d bytes' % (self.name, key, self.key_size))
+        self.entries.append((key, bytes(record)))
+
+    def pack(self):
+        self.entries.sort(key=lambda entry: entry[0])
+        keys = [key for key, _ in self.entries]
+        if len(set(keys)) != len(keys):
+            raise ValueError('%s: duplicate keys' % self.name)
+
+        index_offset = HEADER.size
+        offset = index_offset + len(self.entries) * (self.key_size + 4)
+        index = bytearray()
+        records = bytearray()
+        for key, record in self.entries:
+            index += key + struct.pack('<HH', offset + len(records), len(record))
+            records += record
+        body = bytes(index + records)
+        if HEADER.size + len(body) > 0xffff:
+            raise ValueError('%s: table does not fit 16-bit offsets' % self.name)
+
+        self.checksum = zlib.crc32(body) & 0xffffffff
+        self.index_offset = index_offset
+        return HEADER.pack(MAGIC, TABLE_VERSION, self.key_size, len(self.entries),
+                           self.record_size, index_offset, self.checksum) + body
+
+
+def pack_lists(name, spec, source):
+    """Lists of strings, record: uint16 title, uint16 count, (count + 1) * uint16 offset, strings."""
+    with open(source, encoding='utf-8') as f:
+        lists = yaml.safe_load(f)
+
+    max_items = spec.get('max_items', 256)
+    max_length = spec.get('max_length', 96)
+    table = Table(name, 1, 0)
+    enum = spec['enum']
+    ids = []
+    for position, (key, content) in enumerate(lists.items()):
+        items = [str(item) for item in content['items']]
+        if len(items) > max_items:
+            raise ValueError('%s.%s: more than %d items' % (name, key, max_items))
+        strings = [str(content['title'])] + items
+        for text in strings:
+            if len(text.encode('utf-8')) > max_length:
+                raise ValueError('%s.%s: "%s" longer than %d bytes' % (name, key, text, max_length))
+
+        header_size = 4 + 2 * (len(items) + 1)
+        offsets = []
+        blob = bytearray()
+        for text in strings:
+            offsets.append(header_size + len(blob))
+            blob += text.encode('utf-8') + b'\0'
+        offsets.append(header_size + len(blob))
+        record = struct.pack('<HH', offsets[0], len(items)) + struct.pack('<%dH' % (len(items) + 1), *offsets[1:]) + blob
+        table.add(struct.pack('<B', position), record)
+        ids.append('%s_%s' % (enum, key.upper()))
+
+    table.defines.append('enum {\n%s\n};' % ',\n'.join('  ' + name for name in ids))
+    table.defines.append('#define DATA_%s_MAX_ITEMS %d' % (name.upper(), max_items))
+    return table
+
+
+def field_format(field_type):
+    if field_type.startswith('char'):
+        size = int(field_type[4:])
+        return '%ds' % size, 'char', size
+    fmt, c_type = FIELD_TYPES[field_type]
+    return fmt, c_type, struct.calcsize(fmt)
+
+
+def pack_records(name, spec, source):
+    fields = [(field['name'], field['type'], field.get('scale', 1)) for field in spec['fields']]
+    record_format = struct.Struct('<' + ''.join(field_format(t)[0] for _, t, _ in fields))
+    key_name = spec['key']
+    key_type = next(t for n, t, _ in fields if n == key_name)
+    key_format = struct.Struct('<' + field_format(key_type)[0])
+
+    def convert(field_type, scale, text):
+        if field_type.startswith('char'):
+            return text.encode('utf-8')
+        return int(round(float(text) * scale))
+
+    table = Table(name, key_format.size, record_format.size)
+    with open(source, encoding='utf-8', newline='') as f:
+        rows = [row for row in csv.DictReader(f) if not next(iter(row.values()), '').startswith('#')]
+    for row in rows:
+        values = [convert(t, scale, row[n].strip()) for n, t, scale in fields]
+        key = key_format.pack(values[[n for n, _, _ in fields].index(key_name)])
+        table.add(key, record_format.pack(*values))
+
+    members = []
+    for field_name, field_type, scale in fields:
+        _, c_type, size = field_format(field_type)
+        comment = '  // x%d' % scale if scale != 1 else ''
+        if c_type == 'char':
+            members.append('  char %s[%d];%s' % (field_name, size, comment))
+        else:
+            members.append('  %s %s;%s' % (c_type, field_name, comment))
+    table.defines.append('typedef struct __attribute__((__packed__)) {\n%s\n} data_%s_record_t;'
+                         % ('\n'.join(members), name))
+    return table
+
+
+PACKERS = {'lists': pack_lists, 'records': pack_records}
+
+
+def register_resources(package_path, names):
+    with open(package_path) as f:
+        package = json.load(f)
+    media = package['pebble']['resources']['media']
+    known = set(entry['file'] for entry in media)
+    changed = False
+    for name in names:
+        path = 'data/%s.bin' % name
+        if path not in known:
+            media.append({'file': path, 'name': name.upper(), 'targetPlatforms': None, 'type': 'raw'})
+            changed = True
+    if changed:
+        with open(package_path, 'w') as f:
+            f.write(json.dumps(package, indent=4, sort_keys=True) + '\n')
+
+
+def write_if_changed(path, data):
+    if os.path.exists(path):
+        with open(path, 'rb') as f:
+            if f.read() == data:
+                return
+    with open(path, 'wb') as f:
+        f.write(data)
+
+
+def write_header(path, tables):
+    lines = ['// Generated by tools/pack_resources.py from resources/data/tables.yaml, do not edit.',
+             '#pragma once', '#include <pebble.h>', '',
+             '#define DATA_TABLE_MAGIC "%s"' % MAGIC.decode(),
+             '#define DATA_TABLE_VERSION %d' % TABLE_VERSION,
+             '#define DATA_TABLE_HEADER_SIZE %d' % HEADER.size]
+    for table in tables:
+        prefix = 'DATA_' + table.name.upper()
+        lines += ['',
+                  '#define %s_RESOURCE RESOURCE_ID_%s' % (prefix, table.name.upper()),
+                  '#define %s_COUNT %d' % (prefix, len(table.entries)),
+                  '#define %s_KEY_SIZE %d' % (prefix, table.key_size),
+                  '#define %s_INDEX_OFFSET %d' % (prefix, table.index_offset),
+                  '#define %s_RECORD_SIZE %d' % (prefix, table.record_size),
+                  '#define %s_CHECKSUM 0x%08xu' % (prefix, table.checksum)]
+        lines += table.defines
+    os.makedirs(os.path.dirname(path), exist_ok=True)
+    write_if_changed(path, ('\n'.join(lines) + '\n').encode('utf-8'))
+
+
+def pack_all(project):
+    data_dir = os.path.join(project, 'resources', 'data')
+    with open(os.path.join(data_dir, 'tables.yaml')) as f:
+        manifest = yaml.safe_load(f)
+
+    tables = []
+    for name, spec in manifest.items():
+        table = PACKERS[spec['kind']](name, spec, os.path.join(data_dir, spec['source']))
+        write_if_changed(os.path.join(data_dir, name + '.bin'), table.pack())
+        tables.append(table)
+
+    register_resources(os.path.join(project, 'package.json'), [table.name for table in tables])
+    write_header(os.path.join(project, 'src', 'c', 'generated', 'data_tables.h'), tables)
+    return tables
+
+
+if __name__ == '__main__':
+    for table in pack_all(sys.argv[1] if len(sys.argv) > 1 else '.'):
+        print('%s: %d records, checksum 0x%08x' % (table.name, len(table.entries), table.checksum))
@@ -0,0 +1,311 @@
+#!/usr/bin/env python3
+"""Run a scenario against the watchapp on the desktop, with time warped.
+
+The whole of src/c is compiled with the host stand-in for the SDK in
+tools/host, so the mission, alarm and battery logic run unchanged. Timers
+and ticks fire on a virtual clock: six hours of flight take a few
+milliseconds.
+
+    tools/simulate.py tools/sim/six_hour_flight.txt
+    tools/simulate.py SCENARIO --golden expected.txt [--update]
+    tools/simulate.py SCENARIO --golden-frames DIR [--update]
+
+The timeline lists the telemetry events, vibrations, backlight and app logs
+with the time elapsed since the start. With --golden the timeline is
+compared with the file, --update rewrites it instead.
+
+The frame command of a scenario renders the screen into
+build/host/frames/NAME.png, with the render time printed on stderr. Text
+is drawn with a fixed-pitch 5x7 font, so the frames show where things land
+rather than how the watch draws them. --golden-frames compares every frame
+pixel for pixel with DIR/NAME.png.
+
+--platform chalk or emery builds for the round or the large display
+instead of basalt, into build/host-PLATFORM.
+
+See tools/host/sim.c for the scenario commands. Needs a C compiler; CC
+overrides cc. The app is built with the warnings on, at -Os like the watch
+build, so the range checks of the format warnings run.
+"""
+
+import argparse
+import difflib
+import glob
+import json
+import os
+import struct
+import subprocess
+import sys
+import zlib
+
+import pack_resources
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+HOST = os.path.join(ROOT, 'tools', 'host')
+# First message key value assigned by the SDK
+MESSAGE_KEY_BASE = 10000
+
+
+def png_read(path):
+    """Width, height and rows of (r, g, b, a), for 8-bit and lower depths."""
+    with open(path, 'rb') as f:
+        data = f.read()
+    if data[:8] != b'\x89PNG\r\n\x1a\n':
+        raise ValueError('%s: not a PNG' % path)
+    offset, idat, palette, transparency = 8, b'', [], b''
+    while offset < len(data):
+        length, kind = struct.unpack('>I4s', data[offset:offset + 8])
+        chunk = data[offset + 8:offset + 8 + length]
+        if kind == b'IHDR':
+            width, height, depth, color_type, _, _, interlace = struct.unpack('>IIBBBBB', chunk)
+        elif kind == b'PLTE':
+            palette = [tuple(chunk[i:i + 3]) for i in range(0, len(chunk), 3)]
+        elif kind == b'tRNS':
+            transparency = chunk
+        elif kind == b'IDAT':
+            idat += chunk
+        offset += length + 12
+    if interlace or depth == 16:
+        raise ValueError('%s: interlaced and 16-bit images are not supported' % path)
+
+    channels = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}[color_type]
+    pixel_bytes = max(1, channels * depth // 8)
+    stride = (width * channels * depth + 7) // 8
+    raw = zlib.decompress(idat)
+    rows, previous = [], bytearray(stride)
+    for y in range(height):
+        kind = raw[y * (stride + 1)]
+        line = bytearray(raw[y * (stride + 1) + 1:(y + 1) * (stride + 1)])
+        for i in range(stride):
+            left = line[i - pixel_bytes] if i >= pixel_bytes else 0
+            up = previous[i]
+            corner = previous[i - pixel_bytes] if i >= pixel_bytes else 0
+            if kind == 1:
+                line[i] = (line[i] + left) & 0xff
+            elif kind == 2:
+                line[i] = (line[i] + up) & 0xff
+            elif kind == 3:
+                line[i] = (line[i] + (left + up) // 2) & 0xff
+            elif kind == 4:
+                p = left + up - corner
+                pa, pb, pc = abs(p - left), abs(p - up), abs(p - corner)
+                line[i] = (line[i] + (left if pa <= pb and pa <= pc else up if pb <= pc else corner)) & 0xff
+        previous = line
+
+        samples = [(line[bit // 8] >> (8 - depth - bit % 8)) & ((1 << depth) - 1)
+                   for bit in range(0, width * channels * depth, depth)]
+        row = []
+        for x in range(width):
+            sample = samples[x * channels:(x + 1) * channels]
+            if color_type == 3:
+                r, g, b = palette[sample[0]]
+                a = transparency[sample[0]] if sample[0] < len(transparency) else 255
+            else:
+                scaled = [v * 255 // ((1 << depth) - 1) for v in sample]
+                if color_type in (0, 4):
+                    r = g = b = scaled[0]
+                else:
+                    r, g, b = scaled[:3]
+                a = scaled[-1] if color_type in (4, 6) else 255
+            row.append((r, g, b, a))
+        rows.append(row)
+    return width, height, rows
+
+
+def png_write(path, width, height, rgb):
+    def chunk(kind, body):
+        return struct.pack('>I', len(body)) + kind + body + struct.pack('>I', zlib.crc32(kind + body))
+    lines = b''.join(b'\x00' + rgb[y * width * 3:(y + 1) * width * 3] for y in range(height))
+    with open(path, 'wb') as f:
+        f.write(b'\x89PNG\r\n\x1a\n')
+        f.write(chunk(b'IHDR', struct.pack('>IIBBBBB', width, height, 8, 2, 0, 0, 0)))
+        f.write(chunk(b'IDAT', zlib.compress(lines, 9)))
+        f.write(chunk(b'IEND', b''))
+
+
+def ppm_read(path):
+    with open(path, 'rb') as f:
+        magic, size, maximum, pixels = f.read().split(b'\n', 3)
+    width, height = map(int, size.split())
+    return width, height, pixels
+
+
+def convert_bitmap(source, target, memory_format):
+    """The HBM1 file read by gbitmap_create_with_resource in tools/host."""
+    width, height, rows = png_read(source)
+    if memory_format == '1Bit':
+        # Word aligned rows, LSB first, transparent counts as white
+        stride = (width + 31) // 32 * 4
+        data = bytearray(stride * height)
+        for y, row in enumerate(rows):
+            for x, (r, g, b, a) in enumerate(row):
+                if a < 128 or (r * 299 + g * 587 + b * 114) // 1000 >= 128:
+                    data[y * stride + x // 8] |= 1 << (x % 8)
+        kind = 0
+    else:
+        data = bytearray((a >> 6) << 6 | (r >> 6) << 4 | (g >> 6) << 2 | b >> 6
+                         for row in rows for r, g, b, a in row)
+        kind = 1
+    write_if_changed(target, b'HBM1' + struct.pack('<HHBx', width, height, kind) + bytes(data), binary=True)
+
+
+def write_if_changed(path, text, binary=False):
+    mode = 'b' if binary else ''
+    if os.path.exists(path):
+        with open(path, 'r' + mode) as f:
+            if f.read() == text:
+                return
+    with open(path, 'w' + mode) as f:
+        f.write(text)
+
+
+def generate(out):
+    """The headers the SDK would generate from package.json."""
+    with open(os.path.join(ROOT, 'package.json')) as f:
+        pebble = json.load(f)['pebble']
+
+    keys = ['#pragma once\n\n#include <stdint.h>\n\n']
+    for index, key in enumerate(pebble.get('messageKeys', [])):
+        keys.append('#define MESSAGE_KEY_%s ((uint32_t)%d)\n' % (key, MESSAGE_KEY_BASE + index))
+    write_if_changed(os.path.join(out, 'message_keys.auto.h'), ''.join(keys))
+
+    media = pebble['resources']['media']
+    ids = ['#pragma once\n\nenum {\n  RESOURCE_ID_INVALID = 0,\n']
+    ids += ['  RESOURCE_ID_%s,\n' % m['name'] for m in media]
+    ids.append('};\n')
+    write_if_changed(os.path.join(out, 'resource_ids.auto.h'), ''.join(ids))
+
+    # Bitmaps are decoded here, the other resources are read as they are
+    files = []
+    os.makedirs(os.path.join(out, 'resources'), exist_ok=True)
+    for m in media:
+        source = os.path.join(ROOT, 'resources', m['file'])
+        if m['type'] == 'bitmap':
+            target = os.path.join(out, 'resources', m['name'] + '.hbm')
+            convert_bitmap(source, target, m.get('memoryFormat'))
+            source = target
+        files.append(source)
+
+    table = ['#include "host.h"\n\n', 'const char *const host_resource_names[] = {\n  NULL,\n']
+    table += ['  "%s",\n' % m['name'] for m in media]
+    table.append('};\n\nconst char *const host_resource_files[] = {\n  NULL,\n')
+    table += ['  "%s",\n' % f for f in files]
+    table.append('};\n\nconst uint32_t host_resource_count = %d;\n' % (len(media) + 1))
+    write_if_changed(os.path.join(out, 'host_resources.auto.c'), ''.join(table))
+
+
+PLATFORMS = ['basalt', 'chalk', 'emery']
+
+
+def build(out, platform):
+    pack_resources.pack_all(ROOT)
+    generate(out)
+
+    cc = os.environ.get('CC', 'cc')
+    flags = ['-std=gnu11', '-g', '-Os', '-Wall', '-Wextra', '-Wno-unused-parameter', '-I', HOST, '-I', out, '-DHOST_PLATFORM_' + platform.upper()]
+    main_c = os.path.join(ROOT, 'src', 'c', 'main.c')
+    sources = [s for s in glob.glob(os.path.join(ROOT, 'src', 'c', '**', '*.c'), recursive=True) if s != main_c]
+    sources += glob.glob(os.path.join(HOST, '*.c'))
+    sources.append(os.path.join(out, 'host_resources.auto.c'))
+
+    # The app's main is renamed so that the simulator can own the process,
+    # it loses the implicit return 0 of main on the way
+    main_o = os.path.join(out, 'main.o')
+    subprocess.check_call([cc] + flags + ['-Dmain=pebble_app_main', '-Wno-return-type', '-c', main_c, '-o', main_o])
+    binary = os.path.join(out, 'sim')
+    subprocess.check_call([cc] + flags + sources + [main_o, '-o', binary, '-lm'])
+    return binary
+
+
+def compare_frames(frames, golden, update):
+    """Pixel differences of each rendered frame with the golden one."""
+    failed = False
+    names = sorted(f[:-4] for f in os.listdir(frames) if f.endswith('.png'))
+    if update:
+        os.makedirs(golden, exist_ok=True)
+    for name in names:
+        actual = os.path.join(frames, name + '.png')
+        expected = os.path.join(golden, name + '.png')
+        if update:
+            with open(actual, 'rb') as source, open(expected, 'wb') as target:
+                target.write(source.read())
+            continue
+        if not os.path.exists(expected):
+            print('frame %s: no golden frame %s' % (name, expected))
+            failed = True
+            continue
+        width, height, rows = png_read(actual)
+        golden_width, golden_height, golden_rows = png_read(expected)
+        if (width, height) != (golden_width, golden_height):
+            print('frame %s: %dx%d instead of %dx%d' % (name, width, height, golden_width, golden_height))
+            failed = True
+            continue
+        different = [(x, y) for y in range(height) for x in range(width)
+                     if rows[y][x][:3] != golden_rows[y][x][:3]]
+        if different:
+            xs, ys = [x for x, _ in different], [y for _, y in different]
+            print('frame %s: %d pixels differ within (%d, %d)-(%d, %d), see %s' % (
+                name, len(different), min(xs), min(ys), max(xs), max(ys), actual))
+            failed = True
+    return not failed
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument('scenario')
+    parser.add_argument('--start', help='UTC start time, YYYY-MM-DDTHH:MM[:SS]')
+    parser.add_argument('--verbose', action='store_true', help='include the debug logs')
+    parser.add_argument('--golden', help='compare the timeline with this file')
+    parser.add_argument('--golden-frames', help='compare the frames with the PNG files in this directory')
+    parser.add_argument('--update', action='store_true', help='rewrite the golden timeline and frames')
+    parser.add_argument('--runs', type=int, default=20, help='renders of each frame for the timing')
+    parser.add_argument('--platform', choices=PLATFORMS, default='basalt')
+    parser.add_argument('--build', help='build directory, build/host by default')
+    args = parser.parse_args()
+
+    if not args.build:
+        name = 'host' if args.platform == 'basalt' else 'host-' + args.platform
+        args.build = os.path.join(ROOT, 'build', name)
+    os.makedirs(args.build, exist_ok=True)
+    binary = build(args.build, args.platform)
+
+    frames = os.path.join(args.build, 'frames')
+    os.makedirs(frames, exist_ok=True)
+    for name in os.listdir(frames):
+        os.remove(os.path.join(frames, name))
+
+    command = [binary, args.scenario, '--frames', frames, '--runs', str(args.runs)]
+    if args.start:
+        command += ['--start', args.start]
+    if args.verbose:
+        command.append('--verbose')
+    result = subprocess.run(command, stdout=subprocess.PIPE, universal_newlines=True,
+                            env=dict(os.environ, TZ='UTC'))
+    if result.returncode:
+        sys.exit(result.returncode)
+
+    for name in sorted(os.listdir(frames)):
+        if name.endswith('.ppm'):
+            ppm = os.path.join(frames, name)
+            png_write(ppm[:-4] + '.png', *ppm_read(ppm))
+            os.remove(ppm)
+    if args.golden_frames and not compare_frames(frames, args.golden_frames, args.update):
+        sys.exit(1)
+
+    if not args.golden:
+        sys.stdout.write(result.stdout)
+    elif args.update:
+        with open(args.golden, 'w') as f:
+            f.write(result.stdout)
+    else:
+        with open(args.golden) as f:
+            expected = f.read()
+        diff = list(difflib.unified_diff(expected.splitlines(True), result.stdout.splitlines(True),
+                                         args.golden, 'simulated'))
+        if diff:
+            sys.stdout.writelines(diff)
+            sys.exit(1)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,71 @@
+#!/usr/bin/env python3
+"""Decode the FlightLevel telemetry DataLogging session.
+
+Download the session (tag 0x464C0001) from the emulator or a watch with the
+pebble tool's data-logging command, then pass the resulting file here:
+
+    tools/telemetry_decode.py session.bin [--csv]
+
+Each record is the packed telemetry_record_t from
+src/c/services/telemetry.h: uint32 timestamp, uint16 ms, uint8 event,
+uint8 arg, little-endian.
+"""
+
+import argparse
+import datetime
+import struct
+import sys
+
+RECORD = struct.Struct('<IHBB')
+
+EVENTS = ['phase_next', 'phase_cancel', 'alarm_fire', 'alarm_ack', 'et_flyback', 'waypoint', 'touch_and_go']
+PHASES = ['preflight', 'taxi_dep', 'inflight', 'taxi_arr', 'postflight']
+ALARMS = ['cruise_check', 'endurance', 'flight_plan', 'battery']
+
+
+def describe(event, arg):
+    if event in (0, 1):
+        return PHASES[arg] if arg < len(PHASES) else str(arg)
+    if event in (2, 3):
+        return ALARMS[arg] if arg < len(ALARMS) else str(arg)
+    if event == 5:
+        return 'waypoint %d' % arg
+    if event == 6:
+        return 'landing %d' % arg
+    return ''
+
+
+def decode(data):
+    for offset in range(0, len(data) - RECORD.size + 1, RECORD.size):
+        timestamp, ms, event, arg = RECORD.unpack_from(data, offset)
+        name = EVENTS[event] if event < len(EVENTS) else 'event_%d' % event
+        yield timestamp, ms, name, describe(event, arg)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument('session', help='raw session data, "-" for stdin')
+    parser.add_argument('--csv', action='store_true', help='emit CSV instead of a readable timeline')
+    args = parser.parse_args()
+
+    if args.session == '-':
+        data = sys.stdin.buffer.read()
+    else:
+        with open(args.session, 'rb') as f:
+            data = f.read()
+
+    if len(data) % RECORD.size:
+        print('warning: %d trailing bytes ignored' % (len(data) % RECORD.size), file=sys.stderr)
+
+    if args.csv:
+        print('timestamp,ms,event,detail')
+    for timestamp, ms, name, detail in decode(data):
+        if args.csv:
+            print('%d,%d,%s,%s' % (timestamp, ms, name, detail))
+        else:
+            when = datetime.datetime.fromtimestamp(timestamp, datetime.timezone.utc)
+            print('%s.%03dZ  %-12s %s' % (when.strftime('%Y-%m-%d %H:%M:%S'), ms, name, detail))
+
+
+if __name__ == '__main__':
+    main()